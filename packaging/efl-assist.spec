@@ -12,6 +12,8 @@ BuildRequires:  pkgconfig(vconf)
 BuildRequires:  pkgconfig(tts)
 BuildRequires:  pkgconfig(capi-base-common)
 BuildRequires:  pkgconfig(capi-appfw-application)
+Requires:   tts
+Requires:   vconf
 Requires(post): /sbin/ldconfig
 Requires(postun): /sbin/ldconfig
 
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+/* Headless editfield benchmark. Elementary runs on the buffer engine, so it
+ * needs no display. It measures ea_editfield_add() per type, focus changes
+ * and typing bursts, and writes the results as JSON. There is no input
+ * method, so a keystroke is a hand-fired "preedit,changed" smart callback
+ * followed by an insert, not a real IMF preedit.
+ *
+ * usage: ea-editfield-bench [-n iterations] [-o result.json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <Elementary.h>
+#include "efl_assist.h"
+
+#define BENCH_ITERATIONS 50
+#define BENCH_BURST_LEN  10   //keystrokes per typing burst
+
+//Count every allocation of the process. Each step is measured for a plain
+//elm_entry too, so the difference is what the editfield callbacks cost.
+//Only the main thread is counted. The Evas and Ecore worker threads allocate
+//at their own pace and would make the counts differ from run to run.
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long allocs = 0;
+static __thread Eina_Bool counting = EINA_FALSE;
+
+void *
+malloc(size_t size)
+{
+   if (counting) allocs++;
+   return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+   if (counting) allocs++;
+   return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+   if (counting) allocs++;
+   return __libc_realloc(ptr, size);
+}
+
+typedef struct _Bench_Counter
+{
+   double time;
+   unsigned long allocs;
+   unsigned long signals;
+   unsigned int count;
+} Bench_Counter;
+
+static const struct
+{
+   Ea_Editfield_Type type;
+   const char *name;
+} types[] =
+{
+   { EA_EDITFIELD_SINGLELINE, "singleline" },
+   { EA_EDITFIELD_MULTILINE, "multiline" },
+   { EA_EDITFIELD_SCROLL_SINGLELINE, "scroll_singleline" },
+   { EA_EDITFIELD_SCROLL_MULTILINE, "scroll_multiline" },
+   { EA_EDITFIELD_SCROLL_SINGLELINE_PASSWORD, "scroll_singleline_password" },
+   { EA_EDITFIELD_SEARCHBAR, "searchbar" }
+};
+
+static unsigned long signals = 0;
+static Evas_Object *win = NULL;
+
+static void
+_signal_cb(void *data, Evas_Object *obj, const char *emission, const char *source)
+{
+   signals++;
+}
+
+//Let the deferred work (signals, recalculation) run before stopping the clock.
+static void
+_flush(Evas_Object *obj)
+{
+   edje_message_signal_process();
+   evas_object_smart_calculate(obj);
+   ecore_main_loop_iterate();
+}
+
+static void
+_counter_start(double *t, unsigned long *a, unsigned long *s)
+{
+   *s = signals;
+   *a = allocs;
+   *t = ecore_time_get();
+}
+
+static void
+_counter_stop(Bench_Counter *c, double t, unsigned long a, unsigned long s)
+{
+   c->time += ecore_time_get() - t;
+   c->allocs += allocs - a;
+   c->signals += signals - s;
+   c->count++;
+}
+
+static Evas_Object *
+_field_add(Ea_Editfield_Type type, Eina_Bool plain)
+{
+   Evas_Object *obj;
+
+   if (plain)
+     obj = elm_entry_add(win);
+   else
+     obj = ea_editfield_add(win, type);
+   if (!obj) return NULL;
+
+   elm_object_signal_callback_add(obj, "elm,state,*", "*", _signal_cb, NULL);
+   evas_object_resize(obj, 480, 80);
+   evas_object_show(obj);
+
+   return obj;
+}
+
+static void
+_bench_create(FILE *out, int iterations)
+{
+   Bench_Counter warm;
+   Evas_Object *obj;
+   double t, cold;
+   unsigned long a, s;
+   unsigned int i;
+   int n;
+
+   fprintf(out, "  \"create\": [\n");
+   for (i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+     {
+        memset(&warm, 0, sizeof(warm));
+
+        //The first one loads the theme groups and the fonts.
+        t = ecore_time_get();
+        obj = ea_editfield_add(win, types[i].type);
+        _flush(obj);
+        cold = ecore_time_get() - t;
+        evas_object_del(obj);
+
+        for (n = 0; n < iterations; n++)
+          {
+             _counter_start(&t, &a, &s);
+             obj = ea_editfield_add(win, types[i].type);
+             _flush(obj);
+             _counter_stop(&warm, t, a, s);
+             evas_object_del(obj);
+          }
+
+        fprintf(out, "    { \"type\": \"%s\", \"cold_ms\": %.3f, "
+                "\"warm_ms\": %.3f, \"allocs\": %.1f }%s\n",
+                types[i].name, cold * 1000.0,
+                warm.time * 1000.0 / warm.count,
+                (double) warm.allocs / warm.count,
+                (i + 1 < sizeof(types) / sizeof(types[0])) ? "," : "");
+     }
+   fprintf(out, "  ],\n");
+}
+
+static void
+_bench_focus(Bench_Counter *c, Eina_Bool plain, int iterations)
+{
+   Evas_Object *field[2];
+   double t;
+   unsigned long a, s;
+   int n;
+
+   field[0] = _field_add(EA_EDITFIELD_SINGLELINE, plain);
+   field[1] = _field_add(EA_EDITFIELD_SINGLELINE, plain);
+   elm_entry_entry_set(field[0], "focus");
+   elm_entry_entry_set(field[1], "focus");
+   _flush(field[0]);
+
+   for (n = 0; n < iterations; n++)
+     {
+        _counter_start(&t, &a, &s);
+        elm_object_focus_set(field[n % 2], EINA_TRUE);
+        _flush(field[n % 2]);
+        _counter_stop(c, t, a, s);
+     }
+
+   evas_object_del(field[0]);
+   evas_object_del(field[1]);
+}
+
+static void
+_bench_typing(Bench_Counter *c, Eina_Bool plain, int iterations)
+{
+   static const char burst[BENCH_BURST_LEN + 1] = "abcdefghij";
+   char key[2] = { 0, 0 };
+   Evas_Object *obj;
+   double t;
+   unsigned long a, s;
+   int n, i;
+
+   obj = _field_add(EA_EDITFIELD_SINGLELINE, plain);
+   elm_object_focus_set(obj, EINA_TRUE);
+   _flush(obj);
+
+   for (n = 0; n < iterations; n++)
+     {
+        elm_entry_entry_set(obj, "");
+        _flush(obj);
+
+        for (i = 0; i < BENCH_BURST_LEN; i++)
+          {
+             key[0] = burst[i];
+
+             //Stands in for a keystroke of an input method: the editfield's
+             //"preedit,changed" handlers, then the commit.
+             _counter_start(&t, &a, &s);
+             evas_object_smart_callback_call(obj, "preedit,changed", NULL);
+             elm_entry_entry_insert(obj, key);
+             _flush(obj);
+             _counter_stop(c, t, a, s);
+          }
+     }
+
+   evas_object_del(obj);
+}
+
+static void
+_counter_print(FILE *out, const char *widget, const char *unit, Bench_Counter *c, Eina_Bool last)
+{
+   unsigned int count = c->count ? c->count : 1;
+
+   fprintf(out, "    { \"widget\": \"%s\", \"%s_ms\": %.4f, "
+           "\"signals_per_%s\": %.2f, \"allocs_per_%s\": %.2f }%s\n",
+           widget, unit, c->time * 1000.0 / count,
+           unit, (double) c->signals / count,
+           unit, (double) c->allocs / count,
+           last ? "" : ",");
+}
+
+int
+main(int argc, char **argv)
+{
+   Bench_Counter entry, editfield;
+   const char *path = NULL;
+   int iterations = BENCH_ITERATIONS;
+   FILE *out = stdout;
+   int opt;
+
+   while ((opt = getopt(argc, argv, "n:o:")) != -1)
+     {
+        switch (opt)
+          {
+           case 'n':
+              iterations = atoi(optarg);
+              break;
+           case 'o':
+              path = optarg;
+              break;
+           default:
+              fprintf(stderr, "usage: %s [-n iterations] [-o result.json]\n", argv[0]);
+              return 1;
+          }
+     }
+   if (iterations < 1) iterations = 1;
+   counting = EINA_TRUE;
+
+   //No display is needed.
+   setenv("ELM_ENGINE", "buffer", 1);
+   setenv("EA_TTS_BACKEND", "local", 1);
+   elm_init(argc, argv);
+
+   win = elm_win_add(NULL, "ea-editfield-bench", ELM_WIN_BASIC);
+   if (!win)
+     {
+        fprintf(stderr, "Failed to create the window\n");
+        elm_shutdown();
+        return 1;
+     }
+   evas_object_resize(win, 480, 800);
+   evas_object_show(win);
+
+   if (path)
+     {
+        out = fopen(path, "w");
+        if (!out)
+          {
+             fprintf(stderr, "Failed to open %s\n", path);
+             evas_object_del(win);
+             elm_shutdown();
+             return 1;
+          }
+     }
+
+   fprintf(out, "{\n  \"benchmark\": \"editfield\",\n"
+           "  \"engine\": \"buffer\",\n  \"iterations\": %d,\n", iterations);
+
+   _bench_create(out, iterations);
+
+   memset(&entry, 0, sizeof(entry));
+   memset(&editfield, 0, sizeof(editfield));
+   _bench_focus(&entry, EINA_TRUE, iterations);
+   _bench_focus(&editfield, EINA_FALSE, iterations);
+   fprintf(out, "  \"focus\": [\n");
+   _counter_print(out, "entry", "switch", &entry, EINA_FALSE);
+   _counter_print(out, "editfield", "switch", &editfield, EINA_TRUE);
+   fprintf(out, "  ],\n");
+
+   memset(&entry, 0, sizeof(entry));
+   memset(&editfield, 0, sizeof(editfield));
+   _bench_typing(&entry, EINA_TRUE, iterations);
+   _bench_typing(&editfield, EINA_FALSE, iterations);
+   fprintf(out, "  \"typing_fake_preedit_cb\": [\n");
+   _counter_print(out, "entry", "keystroke", &entry, EINA_FALSE);
+   _counter_print(out, "editfield", "keystroke", &editfield, EINA_TRUE);
+   fprintf(out, "  ]\n}\n");
+
+   if (out != stdout) fclose(out);
+
+   evas_object_del(win);
+   elm_shutdown();
+
+   return 0;
+}
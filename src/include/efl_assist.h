@@ -21,7 +21,13 @@
 
 #include "efl_assist_editfield.h"
 #include "efl_assist_events.h"
+#include "efl_assist_form.h"
+#include "efl_assist_memory.h"
+#include "efl_assist_naviframe.h"
+#include "efl_assist_pool.h"
 #include "efl_assist_screen_reader.h"
+#include "efl_assist_search_history.h"
+#include "efl_assist_text.h"
 
 #endif /* __EFL_ASSIST_H__ */
 
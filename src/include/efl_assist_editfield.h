@@ -42,6 +42,14 @@ typedef enum
    EA_EDITFIELD_SEARCHBAR
 } Ea_Editfield_Type;
 
+typedef enum
+{
+   EA_EDITFIELD_ACCESS_LABEL_CLEAR,      /**< The clear button. "Clear text" by default. */
+   EA_EDITFIELD_ACCESS_LABEL_EMPTY,      /**< The state of an empty field. "Empty" by default. */
+   EA_EDITFIELD_ACCESS_LABEL_PASSWORD,   /**< A password field, its text is never read. "Password" by default. */
+   EA_EDITFIELD_ACCESS_LABEL_LAST
+} Ea_Editfield_Access_Label;
+
 /**
  * @brief Add an elementary entry widget with clear button and rename icon.
  *
@@ -103,6 +111,361 @@ void ea_editfield_clear_button_disabled_set(Evas_Object *obj, Eina_Bool disable)
  */
 Eina_Bool ea_editfield_clear_button_disabled_get(Evas_Object *obj);
 
+/**
+ * @brief Set a label the screen reader reads for the editfields.
+ *
+ * @details The labels are used by all editfields of the process. By default they are
+ *          translated in the "efl-assist" text domain, with the English text as the
+ *          message id. Set the labels from the string table of the application to
+ *          have them in its language.
+ *
+ * @param [in] label the label to be set
+ * @param [in] text the text to be read, or NULL for the default
+ */
+void ea_editfield_access_label_set(Ea_Editfield_Access_Label label, const char *text);
+
+/**
+ * @brief Get the text of the editfield as UTF-8 plain text.
+ *
+ * @details The converted text is cached until the text or the preedit string of the entry
+ *          changes, so it can be read repeatedly (e.g. in several "changed" callbacks)
+ *          without converting the markup each time.
+ *          The returned string is owned by the editfield and it is valid until the next change.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @return the UTF-8 plain text, or NULL if @p obj is not an editfield
+ *
+ */
+const char *ea_editfield_text_utf8_get(Evas_Object *obj);
+
+/**
+ * @typedef Ea_Editfield_Load_Cb
+ *
+ * Progress callback of the text loading.
+ *
+ * @param data The data pointer passed to the loading function
+ * @param obj The entry widget object
+ * @param loaded The number of source bytes appended so far
+ * @param total The total number of source bytes. Loading is done when
+ *              @p loaded is equal to @p total.
+ *
+ * @see ea_editfield_text_load()
+ */
+typedef void (*Ea_Editfield_Load_Cb)(void *data, Evas_Object *obj, size_t loaded, size_t total);
+
+/**
+ * @brief Load a plain text file into the editfield in the background.
+ *
+ * @details The file is memory-mapped, escaped to markup and appended to the entry
+ *          chunk by chunk in idlers, so the entry stays responsive while loading
+ *          a large text. The current text of the entry is removed first.
+ *          Loading is canceled when another loading starts, the clear button
+ *          is clicked or the entry is deleted.
+ *          This is intended for EA_EDITFIELD_SCROLL_MULTILINE editfields.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] path the UTF-8 plain text file to load
+ * @param [in] func the progress callback. It can be NULL.
+ * @param [in] data the data pointer to be passed to @p func
+ *
+ * @return EINA_TRUE if loading is started, EINA_FALSE otherwise
+ *
+ * @see ea_editfield_text_buffer_load()
+ * @see ea_editfield_text_load_cancel()
+ */
+Eina_Bool ea_editfield_text_load(Evas_Object *obj, const char *path, Ea_Editfield_Load_Cb func, void *data);
+
+/**
+ * @brief Load a plain text buffer into the editfield in the background.
+ *
+ * @details Same as ea_editfield_text_load() but the text is copied from @p buf.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] buf the UTF-8 plain text
+ * @param [in] len the length of @p buf in bytes
+ * @param [in] func the progress callback. It can be NULL.
+ * @param [in] data the data pointer to be passed to @p func
+ *
+ * @return EINA_TRUE if loading is started, EINA_FALSE otherwise
+ *
+ * @see ea_editfield_text_load()
+ */
+Eina_Bool ea_editfield_text_buffer_load(Evas_Object *obj, const char *buf, size_t len, Ea_Editfield_Load_Cb func, void *data);
+
+/**
+ * @brief Cancel the text loading of the editfield.
+ *
+ * @details The text which has been appended so far remains in the entry.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @see ea_editfield_text_load()
+ */
+void ea_editfield_text_load_cancel(Evas_Object *obj);
+
+/**
+ * @typedef Ea_Editfield_Charset
+ *
+ * A compiled set of characters for the editfield input filter.
+ *
+ * @see ea_editfield_charset_new()
+ */
+typedef struct _Ea_Editfield_Charset Ea_Editfield_Charset;
+
+/**
+ * @typedef Ea_Editfield_Filter
+ *
+ * Input filter of the editfield.
+ *
+ * @see ea_editfield_filter_set()
+ */
+typedef struct _Ea_Editfield_Filter
+{
+   Ea_Editfield_Charset *accepted; /**< Characters which can be inserted. NULL accepts all characters. */
+   int max_char_count; /**< Maximum number of characters. 0 means no limit. */
+   int max_byte_count; /**< Maximum number of UTF-8 bytes. 0 means no limit. */
+} Ea_Editfield_Filter;
+
+/**
+ * @brief Compile a set of characters for the editfield input filter.
+ *
+ * @details @p spec is a UTF-8 string listing the characters of the set.
+ *          A range of characters can be given as "a-z". A '-' at the beginning
+ *          or the end of @p spec, or escaped with a backslash, is the character itself.
+ *          A backslash itself is given as two backslashes.
+ *          Membership test of the compiled set doesn't depend on the length of @p spec.
+ *
+ * @param [in] spec the characters of the set, e.g. "a-zA-Z0-9_."
+ *
+ * @return the compiled set or NULL on failure
+ *
+ * @see ea_editfield_charset_free()
+ * @see ea_editfield_filter_set()
+ */
+Ea_Editfield_Charset *ea_editfield_charset_new(const char *spec);
+
+/**
+ * @brief Free a set of characters.
+ *
+ * @details The editfields which use @p charset in their filters keep their own reference,
+ *          so @p charset can be freed right after ea_editfield_filter_set().
+ *
+ * @param [in] charset the compiled set of characters
+ *
+ * @see ea_editfield_charset_new()
+ */
+void ea_editfield_charset_free(Ea_Editfield_Charset *charset);
+
+/**
+ * @brief Set the input filter of the editfield.
+ *
+ * @details The characters not in the accepted set are dropped from the inserted text and
+ *          the inserted text is truncated to keep the length limits.
+ *          The editfield keeps a running count of characters and bytes, updated from
+ *          the change information of the entry, so the cost of each insertion depends
+ *          only on the length of the inserted text.
+ *          Setting the text with elm_entry_entry_set() makes the editfield count the
+ *          whole text again at the next insertion.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] filter the filter. The content is copied. NULL removes the filter.
+ *
+ * @see ea_editfield_filter_remaining_get()
+ */
+void ea_editfield_filter_set(Evas_Object *obj, const Ea_Editfield_Filter *filter);
+
+/**
+ * @brief Get the number of characters which can still be inserted into the editfield.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @return the number of remaining characters, or -1 if there is no character limit
+ *
+ * @see ea_editfield_filter_set()
+ */
+int ea_editfield_filter_remaining_get(Evas_Object *obj);
+
+/**
+ * @typedef Ea_Editfield_Preload_Cb
+ *
+ * Callback called when the editfield styles are preloaded.
+ *
+ * @param data The data pointer passed to ea_editfield_styles_preload()
+ * @param parent The parent object passed to ea_editfield_styles_preload()
+ *
+ * @see ea_editfield_styles_preload()
+ */
+typedef void (*Ea_Editfield_Preload_Cb)(void *data, Evas_Object *parent);
+
+/**
+ * @brief Preload the theme groups and fonts of all editfield types in the background.
+ *
+ * @details Creating the first editfield of each type loads and parses its theme groups
+ *          and fonts. This function creates and calculates a hidden editfield of each type,
+ *          one per idler, so the theme data and fonts are cached before the application
+ *          shows its first form. It is canceled if @p parent is deleted.
+ *
+ * @param [in] parent the parent widget object, usually the window
+ * @param [in] func the callback called when all types are preloaded. It can be NULL.
+ * @param [in] data the data pointer to be passed to @p func
+ *
+ * @see ea_editfield_add()
+ */
+void ea_editfield_styles_preload(Evas_Object *parent, Ea_Editfield_Preload_Cb func, void *data);
+
+/**
+ * @brief Enable or disable the undo/redo history of the editfield.
+ *
+ * @details The history records the insertions and deletions made by the user from the change
+ *          information of the entry. Each record keeps only the changed text, so undo and redo
+ *          cost as much as the edit itself regardless of the length of the text.
+ *          The history is cleared when the text is changed by the application (e.g. elm_entry_entry_set()).
+ *          This is intended for EA_EDITFIELD_SCROLL_MULTILINE editfields.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] enabled EINA_TRUE : record the history
+ *                     EINA_FALSE : discard the history and stop recording
+ *
+ * @see ea_editfield_undo()
+ * @see ea_editfield_history_limit_set()
+ */
+void ea_editfield_history_enabled_set(Evas_Object *obj, Eina_Bool enabled);
+
+/**
+ * @brief Get whether the undo/redo history of the editfield is enabled.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @return EINA_TRUE if the history is enabled
+ */
+Eina_Bool ea_editfield_history_enabled_get(Evas_Object *obj);
+
+/**
+ * @brief Set the memory limit of the undo/redo history.
+ *
+ * @details The oldest records are dropped when the recorded text exceeds @p size bytes.
+ *          The default limit is 64KB.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] size the maximum size of the recorded text in bytes
+ */
+void ea_editfield_history_limit_set(Evas_Object *obj, size_t size);
+
+/**
+ * @brief Undo the last edit of the editfield.
+ *
+ * @details Characters typed in a row are undone together.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @return EINA_TRUE if an edit is undone
+ *
+ * @see ea_editfield_redo()
+ */
+Eina_Bool ea_editfield_undo(Evas_Object *obj);
+
+/**
+ * @brief Redo the last undone edit of the editfield.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @return EINA_TRUE if an edit is redone
+ *
+ * @see ea_editfield_undo()
+ */
+Eina_Bool ea_editfield_redo(Evas_Object *obj);
+
+/**
+ * @brief Save the state of all editfields under the parent.
+ *
+ * @details The text, the cursor position, the selection and the clear button state
+ *          of every editfield under @p parent are serialized into a compact blob.
+ *          The blob can be stored while the application is paused and passed to
+ *          ea_editfield_state_restore() after the same layout is rebuilt.
+ *          The text of a password editfield is not saved, so it is restored empty.
+ *
+ * @param [in] parent the parent object of the editfields
+ *
+ * @return the blob, to be freed with eina_binbuf_free(), or NULL on failure
+ *
+ * @see ea_editfield_state_restore()
+ */
+Eina_Binbuf *ea_editfield_state_save(Evas_Object *parent);
+
+/**
+ * @brief Restore the state of all editfields under the parent.
+ *
+ * @details The editfields are matched with the saved ones by their order and type.
+ *          All editfields are set in one pass with edje recalculation frozen.
+ *          Nothing is changed if the blob doesn't match the editfields.
+ *
+ * @param [in] parent the parent object of the editfields
+ * @param [in] blob the data returned by ea_editfield_state_save()
+ * @param [in] size the size of @p blob in bytes
+ *
+ * @return EINA_TRUE if the state is restored
+ *
+ * @see ea_editfield_state_save()
+ */
+Eina_Bool ea_editfield_state_restore(Evas_Object *parent, const void *blob, size_t size);
+
+/**
+ * @brief Set the order in which the focus moves through a group of editfields.
+ *
+ * @details Each field keeps its previous and next field, so moving the focus doesn't search
+ *          the focus chain of the window. The input panel return key becomes "Next", or
+ *          "Done" on the last field, and the return key ("activated") moves the focus to the
+ *          next field. The next field is focused before the current one is unfocused, so the
+ *          input panel stays up during the move. A field which is already in a chain is
+ *          moved into the new one. A deleted field leaves the chain and its neighbours are
+ *          joined.
+ *
+ * @param [in] fields the editfields in the focus order
+ * @param [in] count the number of @p fields
+ *
+ * @return EINA_TRUE on success, EINA_FALSE if one of @p fields is not an editfield
+ *
+ * @see ea_editfield_focus_move()
+ * @see ea_editfield_focus_chain_unset()
+ */
+Eina_Bool ea_editfield_focus_chain_set(Evas_Object **fields, unsigned int count);
+
+/**
+ * @brief Take the editfield out of its focus chain.
+ *
+ * @details The neighbours of the editfield are joined and its return key type is reset.
+ *
+ * @param [in] obj the entry widget object
+ *
+ * @see ea_editfield_focus_chain_set()
+ */
+void ea_editfield_focus_chain_unset(Evas_Object *obj);
+
+/**
+ * @brief Get the previous or the next editfield in the focus chain.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] dir ELM_FOCUS_PREVIOUS or ELM_FOCUS_NEXT
+ *
+ * @return the editfield, or NULL at the end of the chain
+ *
+ * @see ea_editfield_focus_chain_set()
+ */
+Evas_Object *ea_editfield_focus_chain_get(const Evas_Object *obj, Elm_Focus_Direction dir);
+
+/**
+ * @brief Move the focus to the previous or the next editfield in the focus chain.
+ *
+ * @param [in] obj the entry widget object
+ * @param [in] dir ELM_FOCUS_PREVIOUS or ELM_FOCUS_NEXT
+ *
+ * @return EINA_TRUE if the focus is moved
+ *
+ * @see ea_editfield_focus_chain_set()
+ */
+Eina_Bool ea_editfield_focus_move(Evas_Object *obj, Elm_Focus_Direction dir);
+
 /**
  * @}
  */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_FORM_H__
+#define __EFL_ASSIST_FORM_H__
+
+#include <Elementary.h>
+#include "efl_assist_editfield.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef Ea_Form
+ *
+ * A compact store of editfield values for large forms.
+ *
+ * @brief The form keeps the type, the text and the validation state of every
+ *        field, while editfield widgets exist only for the fields that are
+ *        visible. The usual way is to show the form with a genlist and create
+ *        the editfield of each realized item with ea_form_field_editfield_add()
+ *        in the content_get function of the item class. When the genlist
+ *        deletes the content of an unrealized item, the text is synced back
+ *        to the form.
+ *
+ * @see ea_form_add()
+ */
+typedef struct _Ea_Form Ea_Form;
+
+/**
+ * Validation callback of the form fields.
+ *
+ * @param data The data pointer passed to ea_form_validate_cb_set().
+ * @param form The form.
+ * @param index The index of the field.
+ * @param text The UTF-8 plain text of the field.
+ * @return EINA_TRUE if the text is valid.
+ */
+typedef Eina_Bool (*Ea_Form_Validate_Cb)(void *data, Ea_Form *form, unsigned int index, const char *text);
+
+/**
+ * Create a new form.
+ *
+ * @return The new form, or @c NULL on failure.
+ *
+ * @see ea_form_del()
+ */
+EAPI Ea_Form *ea_form_add(void);
+
+/**
+ * Delete a form.
+ *
+ * @param[in] form The form.
+ *
+ * @brief The editfields which are bound to the form are not deleted, but they
+ *        are not synced to the form anymore.
+ */
+EAPI void ea_form_del(Ea_Form *form);
+
+/**
+ * Append a field to a form.
+ *
+ * @param[in] form The form.
+ * @param[in] type The editfield type of the field.
+ * @param[in] text The initial markup text of the field. Can be @c NULL.
+ * @return    The index of the new field, or -1 on failure.
+ */
+EAPI int ea_form_field_append(Ea_Form *form, Ea_Editfield_Type type, const char *text);
+
+/**
+ * Get the number of fields in a form.
+ *
+ * @param[in] form The form.
+ * @return    The number of fields.
+ */
+EAPI unsigned int ea_form_field_count_get(const Ea_Form *form);
+
+/**
+ * Get the editfield type of a field.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @return    The editfield type.
+ */
+EAPI Ea_Editfield_Type ea_form_field_type_get(const Ea_Form *form, unsigned int index);
+
+/**
+ * Set the markup text of a field.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @param[in] text The markup text.
+ *
+ * @brief If the field has an editfield, the text of the editfield is set too.
+ */
+EAPI void ea_form_field_text_set(Ea_Form *form, unsigned int index, const char *text);
+
+/**
+ * Get the markup text of a field.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @return    The markup text. It is valid until the text of the field changes.
+ */
+EAPI const char *ea_form_field_text_get(Ea_Form *form, unsigned int index);
+
+/**
+ * Set the validation callback of a form.
+ *
+ * @param[in] form The form.
+ * @param[in] func The validation callback, or @c NULL to accept every text.
+ * @param[in] data The data pointer to be passed to @p func.
+ *
+ * @brief The callback is called lazily, when the validation state of a field
+ *        whose text changed is requested.
+ */
+EAPI void ea_form_validate_cb_set(Ea_Form *form, Ea_Form_Validate_Cb func, void *data);
+
+/**
+ * Get the validation state of a field.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @return    EINA_TRUE if the field is valid.
+ */
+EAPI Eina_Bool ea_form_field_valid_get(Ea_Form *form, unsigned int index);
+
+/**
+ * Validate all fields of a form.
+ *
+ * @param[in] form The form.
+ * @return    The index of the first invalid field, or -1 if all fields are
+ *            valid.
+ */
+EAPI int ea_form_validate(Ea_Form *form);
+
+/**
+ * Create an editfield for a field of a form.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @param[in] parent The parent widget object.
+ * @return    A new editfield bound to the field.
+ *
+ * @brief The editfield is created with the type and the text of the field.
+ *        When the editfield is deleted, its text is written back to the form.
+ *        If the field already has an editfield, that editfield is synced and
+ *        unbound first.
+ *
+ * @see ea_form_field_editfield_get()
+ */
+EAPI Evas_Object *ea_form_field_editfield_add(Ea_Form *form, unsigned int index, Evas_Object *parent);
+
+/**
+ * Get the editfield bound to a field of a form.
+ *
+ * @param[in] form The form.
+ * @param[in] index The index of the field.
+ * @return    The editfield, or @c NULL if the field has no editfield now.
+ */
+EAPI Evas_Object *ea_form_field_editfield_get(const Ea_Form *form, unsigned int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_FORM_H__ */
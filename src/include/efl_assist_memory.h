@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_MEMORY_H__
+#define __EFL_ASSIST_MEMORY_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Kinds of the memory held by the library.
+ */
+typedef enum _Ea_Memory_Type
+{
+   EA_MEMORY_EVENT_MGR,     /**< Event managers, one per canvas. */
+   EA_MEMORY_OBJECT_EVENT,  /**< Objects with back/more key callbacks. */
+   EA_MEMORY_CALLBACK,      /**< Registered callbacks. */
+   EA_MEMORY_OBJECT,        /**< Per-object records. */
+   EA_MEMORY_EDITFIELD,     /**< Editfield records. */
+   EA_MEMORY_TTS,           /**< Screen reader and TTS state. */
+   EA_MEMORY_POOL,          /**< Pooled popups and ctxpopups. */
+   EA_MEMORY_PAGE,          /**< Naviframe page builders. */
+   EA_MEMORY_TYPE_LAST
+} Ea_Memory_Type;
+
+/**
+ * Memory held by the library for one kind of record.
+ */
+typedef struct _Ea_Memory_Stats
+{
+   unsigned int count;      /**< Number of live records. */
+   size_t bytes;            /**< Bytes of the live records. */
+} Ea_Memory_Stats;
+
+/**
+ * Get the memory held by the library for a kind of record.
+ *
+ * @return ret EINA_TRUE if @p type is valid.
+ *
+ * @param[in] type The kind of record.
+ * @param[out] stats The live count and bytes.
+ *
+ * @brief  Records still alive when the library is unloaded are reported to
+ *         the log as leaks.
+ */
+EAPI Eina_Bool ea_memory_stats_get(Ea_Memory_Type type, Ea_Memory_Stats *stats);
+
+/**
+ * How much the library should release in ea_memory_trim().
+ */
+typedef enum _Ea_Memory_Trim_Level
+{
+   EA_MEMORY_TRIM_SOFT,     /**< Release what is idle and can be rebuilt cheaply. */
+   EA_MEMORY_TRIM_HARD      /**< Also flush the shared EFL caches. */
+} Ea_Memory_Trim_Level;
+
+/**
+ * Release the memory the library doesn't need right now.
+ *
+ * @param[in] level How much to release.
+ *
+ * @brief  An idle TTS handle and the pending editfield style preloads are
+ *         released. The pooled popups and ctxpopups which are not in use
+ *         and the prebuilt naviframe pages are deleted, and the cached
+ *         highlight markups are dropped. The preload callbacks are called
+ *         right away.
+ *         EA_MEMORY_TRIM_HARD also flushes the Elementary, Edje and Evas
+ *         caches, so the next widgets are slower to create.
+ *         It is called by itself when the application gets the low memory
+ *         event, with EA_MEMORY_TRIM_HARD for the hard warning.
+ */
+EAPI void ea_memory_trim(Ea_Memory_Trim_Level level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_MEMORY_H__ */
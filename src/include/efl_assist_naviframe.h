@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_NAVIFRAME_H__
+#define __EFL_ASSIST_NAVIFRAME_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Callback called to build the content of a naviframe page.
+ *
+ * @param data The data pointer passed to ea_naviframe_page_prebuild_add()
+ * @param naviframe The naviframe
+ * @return The page content to be pushed, or NULL on failure
+ */
+typedef Evas_Object *(*Ea_Naviframe_Page_Build_Cb)(void *data, Evas_Object *naviframe);
+
+/**
+ * Register a page which is likely to be pushed next.
+ *
+ * @return ret EINA_TRUE on success.
+ *
+ * @param[in] naviframe The naviframe.
+ * @param[in] name The name of the page, unique in @p naviframe.
+ * @param[in] func The function which builds the page content.
+ * @param[in] data The data pointer to be passed to @p func.
+ *
+ * @brief  The page content is built by @p func in an idler, one page per
+ *         idle round, and kept hidden until ea_naviframe_page_get() hands it
+ *         out. The earlier registered pages are built first, up to the budget
+ *         of the naviframe. Registering the same name again replaces the
+ *         builder and discards the prebuilt content.
+ *
+ * @see ea_naviframe_page_get()
+ * @see ea_naviframe_page_prebuild_budget_set()
+ */
+EAPI Eina_Bool ea_naviframe_page_prebuild_add(Evas_Object *naviframe, const char *name, Ea_Naviframe_Page_Build_Cb func, const void *data);
+
+/**
+ * Unregister a page and delete its prebuilt content.
+ *
+ * @param[in] naviframe The naviframe.
+ * @param[in] name The name of the page.
+ */
+EAPI void ea_naviframe_page_prebuild_del(Evas_Object *naviframe, const char *name);
+
+/**
+ * Get the content of a registered page to push it.
+ *
+ * @return ret The page content or NULL on failure.
+ *
+ * @param[in] naviframe The naviframe.
+ * @param[in] name The name of the page.
+ *
+ * @brief  The prebuilt content is returned if it is ready, otherwise it is
+ *         built right away. The caller owns the content, usually by pushing
+ *         it with elm_naviframe_item_push(). Another content of the page is
+ *         prebuilt later in the idle time.
+ */
+EAPI Evas_Object *ea_naviframe_page_get(Evas_Object *naviframe, const char *name);
+
+/**
+ * Discard the prebuilt content of a page which became stale.
+ *
+ * @param[in] naviframe The naviframe.
+ * @param[in] name The name of the page, or NULL for all the pages.
+ *
+ * @brief  Call this when the data shown by the page changed. The page is
+ *         built again in the idle time.
+ */
+EAPI void ea_naviframe_page_invalidate(Evas_Object *naviframe, const char *name);
+
+/**
+ * Set how many pages of the naviframe can be kept prebuilt.
+ *
+ * @param[in] naviframe The naviframe.
+ * @param[in] budget The number of prebuilt pages. The default is 2, and 0
+ *            disables the prebuilding.
+ *
+ * @brief  The prebuilt pages hold their widgets and images. Keep the budget
+ *         small for the heavy pages. ea_memory_trim() discards all of them.
+ */
+EAPI void ea_naviframe_page_prebuild_budget_set(Evas_Object *naviframe, unsigned int budget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_NAVIFRAME_H__ */
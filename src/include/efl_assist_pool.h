@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_POOL_H__
+#define __EFL_ASSIST_POOL_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Callback called once to fill a new pooled popup or ctxpopup.
+ *
+ * @param data The data pointer passed to ea_popup_pool_get() or ea_ctxpopup_pool_get()
+ * @param obj The new popup or ctxpopup
+ */
+typedef void (*Ea_Pool_Build_Cb)(void *data, Evas_Object *obj);
+
+/**
+ * Callback called when a pooled popup or ctxpopup goes back into the pool.
+ *
+ * @param data The data pointer passed to ea_popup_pool_get() or ea_ctxpopup_pool_get()
+ * @param obj The popup or ctxpopup, already hidden
+ */
+typedef void (*Ea_Pool_Reset_Cb)(void *data, Evas_Object *obj);
+
+/**
+ * Get a recycled popup.
+ *
+ * @return ret The popup or NULL on failure.
+ *
+ * @param[in] parent The parent object, usually the window.
+ * @param[in] name The name of the popup, unique under @p parent.
+ * @param[in] func The function which fills a new popup (title, content,
+ *            buttons, style and the back key callback).
+ * @param[in] reset The function which undoes what the user of the popup
+ *            changed, or NULL.
+ * @param[in] data The data pointer to be passed to @p func and @p reset.
+ *
+ * @brief  The first call creates the popup and calls @p func. The later calls
+ *         return the same popup, so showing it again doesn't create the
+ *         widgets nor load the theme. Update only what changes (e.g. the
+ *         text) and show it. ea_pool_object_release() hides it, calls @p reset
+ *         and puts it back into the pool. The pool doesn't reset anything by
+ *         itself: without @p reset, the caller must undo everything it
+ *         changed, or the next user gets it. The pooled popup is deleted
+ *         with @p parent, or by ea_memory_trim() while it is not in use.
+ *
+ * @see ea_popup_pool_back_cb()
+ */
+EAPI Evas_Object *ea_popup_pool_get(Evas_Object *parent, const char *name, Ea_Pool_Build_Cb func, Ea_Pool_Reset_Cb reset, const void *data);
+
+/**
+ * Get a recycled ctxpopup.
+ *
+ * @return ret The ctxpopup or NULL on failure.
+ *
+ * @param[in] parent The parent object, usually the window or the naviframe.
+ * @param[in] name The name of the ctxpopup, unique under @p parent.
+ * @param[in] func The function which fills a new ctxpopup (items, style and
+ *            the back key callback).
+ * @param[in] reset The function which undoes what the user of the ctxpopup
+ *            changed (e.g. disabled items), or NULL.
+ * @param[in] data The data pointer to be passed to @p func and @p reset.
+ *
+ * @brief  Same as ea_popup_pool_get() for the ctxpopups like the more menu.
+ *         The ctxpopup goes back into the pool when it is dismissed.
+ *
+ * @see ea_ctxpopup_pool_back_cb()
+ */
+EAPI Evas_Object *ea_ctxpopup_pool_get(Evas_Object *parent, const char *name, Ea_Pool_Build_Cb func, Ea_Pool_Reset_Cb reset, const void *data);
+
+/**
+ * Put a popup or a ctxpopup back into its pool.
+ *
+ * @param[in] obj The object from ea_popup_pool_get() or ea_ctxpopup_pool_get().
+ *
+ * @brief  The popup is hidden, unfocused and reset instead of being
+ *         deleted. The ctxpopup is dismissed and reset. An object which is
+ *         not pooled is deleted.
+ */
+EAPI void ea_pool_object_release(Evas_Object *obj);
+
+/**
+ * @brief Convenient macro function that sends back key events to the pooled
+ *        popup to be put back into the pool.
+ *
+ * @see   ea_object_event_callback_add()
+ * @see   ea_popup_back_cb()
+ */
+static inline void
+ea_popup_pool_back_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   ea_pool_object_release(obj);
+}
+
+/**
+ * @brief Convenient macro function that sends back key events to the pooled
+ *        ctxpopup to be dismissed and put back into the pool.
+ *
+ * @see   ea_object_event_callback_add()
+ * @see   ea_ctxpopup_back_cb()
+ */
+static inline void
+ea_ctxpopup_pool_back_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   ea_pool_object_release(obj);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_POOL_H__ */
@@ -42,17 +42,164 @@ extern "C" {
 /* eina magic types */
 #define EA_MAGIC_NONE 0x87657890
 #define EA_MAGIC_CUTLINK 0x78908765
+#define EA_MAGIC_EVENT_MGR 0x87650001
+#define EA_MAGIC_OBJECT_EVENT 0x87650002
+#define EA_MAGIC_EVENT_CALLBACK 0x87650003
+#define EA_MAGIC_EDITFIELD 0x87650004
 
+/* Every stamp gets a new generation, so a record which was freed and
+ * allocated again at the same address doesn't pass for the old one. */
 typedef unsigned int ea_magic;
-#define EA_MAGIC                ea_magic __magic
+#define EA_MAGIC                ea_magic __magic; unsigned int __generation
 
-#define EA_MAGIC_SET(d, m)      (d)->__magic = (m)
+#define EA_MAGIC_SET(d, m) \
+		do { (d)->__magic = (m); \
+		     (d)->__generation = _ea_magic_generation_next(); } while (0)
+#define EA_MAGIC_GENERATION(d)  ((d)->__generation)
 #define EA_MAGIC_CHECK(d, m)    ((d) && ((d)->__magic == (m)))
+#define EA_MAGIC_GEN_CHECK(d, m, g) \
+		(EA_MAGIC_CHECK(d, m) && ((d)->__generation == (g)))
 #define EA_MAGIC_FAIL(d, m, fn) \
 		_ea_magic_fail((d), (d) ? (d)->__magic : 0, (m), (fn));
 
 void _ea_magic_fail(const void *d, ea_magic m,
 		    ea_magic req_m, const char *fname);
+unsigned int _ea_magic_generation_next(void);
+
+/* lazily loaded libraries */
+typedef struct _Ea_Dl_Symbol
+{
+	const char *name;
+	void **func;
+} Ea_Dl_Symbol;
+
+typedef struct _Ea_Dl_Lib
+{
+	const char *soname;
+	const Ea_Dl_Symbol *symbols;	/* terminated by { NULL, NULL } */
+	void *handle;
+	Eina_Bool failed;
+} Ea_Dl_Lib;
+
+#define EA_DL_SYMBOL(api, name)	{ #name, (void **)&(api).name }
+
+Eina_Bool _ea_dl_load(Ea_Dl_Lib *lib);
+
+/* memory accounting */
+void *_ea_mem_calloc(Ea_Memory_Type type, size_t size);
+void _ea_mem_free(Ea_Memory_Type type, void *ptr, size_t size);
+
+/* efl_assist_object.c */
+typedef struct _Ea_Event_Mgr Ea_Event_Mgr;
+typedef struct _Ea_Object_Event Ea_Object_Event;
+typedef struct _Ea_Editfield_Data Ea_Editfield_Data;
+typedef struct _Ea_Pool_Item Ea_Pool_Item;
+typedef struct _Ea_Naviframe_Data Ea_Naviframe_Data;
+
+/* All efl-assist state of an object. It is found with one pointer keyed
+ * lookup and cleaned up by one DEL callback. */
+typedef struct _Ea_Object_Data
+{
+   Evas_Object *obj;
+   Ea_Event_Mgr *event_mgr;
+   Ea_Object_Event *obj_event;
+   Ea_Editfield_Data *eed;
+   Ea_Pool_Item *pool_item;
+   Ea_Naviframe_Data *naviframe;
+} Ea_Object_Data;
+
+Ea_Object_Data *_ea_object_data_get(const Evas_Object *obj);
+Ea_Object_Data *_ea_object_data_add(Evas_Object *obj);
+void _ea_object_data_release(Ea_Object_Data *od);
+
+/* efl_assist_events.c */
+void _ea_event_object_del(Ea_Object_Data *od);
+
+/* efl_assist_editfield.c */
+typedef struct _Ea_Editfield_Load Ea_Editfield_Load;
+typedef struct _Ea_Editfield_Filter_Data Ea_Editfield_Filter_Data;
+typedef struct _Ea_Editfield_History Ea_Editfield_History;
+typedef struct _Ea_Editfield_Focus Ea_Editfield_Focus;
+
+struct _Ea_Editfield_Data
+{
+   EA_MAGIC;
+   Eina_Bool clear_btn_disabled;
+   Ea_Editfield_Type type;
+   char *text_utf8;
+   Ea_Search_History *search_history;
+   Ea_Editfield_Load *load;
+   Ea_Editfield_Filter_Data *filter;
+   Ea_Editfield_History *history;
+   Ea_Editfield_Focus *focus;
+};
+
+Ea_Editfield_Data *_ea_editfield_data_get(const Evas_Object *obj);
+void _ea_editfield_object_del(Ea_Object_Data *od);
+
+/* efl_assist_editfield_load.c */
+void _ea_editfield_load_free(Ea_Editfield_Data *eed);
+
+/* efl_assist_editfield_filter.c */
+void _ea_editfield_filter_free(Ea_Editfield_Data *eed);
+
+/* efl_assist_editfield_history.c */
+void _ea_editfield_history_free(Ea_Editfield_Data *eed);
+
+/* efl_assist_editfield_focus.c */
+void _ea_editfield_focus_free(Ea_Editfield_Data *eed);
+
+/* efl_assist_editfield_preload.c */
+void _ea_editfield_preload_trim(void);
+
+/* efl_assist_naviframe.c */
+void _ea_naviframe_object_del(Ea_Object_Data *od);
+void _ea_naviframe_trim(void);
+
+/* efl_assist_pool.c */
+void _ea_pool_object_del(Ea_Object_Data *od);
+void _ea_pool_trim(void);
+
+/* efl_assist_screen_reader.c */
+void _ea_screen_reader_shutdown(void);
+void _ea_screen_reader_trim(void);
+
+/* efl_assist_tts.c */
+typedef enum _Ea_Tts_State
+{
+   EA_TTS_STATE_CREATED,
+   EA_TTS_STATE_READY,
+   EA_TTS_STATE_PLAYING,
+   EA_TTS_STATE_PAUSED
+} Ea_Tts_State;
+
+typedef void (*Ea_Tts_State_Changed_Cb)(Ea_Tts_State previous, Ea_Tts_State current);
+typedef void (*Ea_Tts_Completed_Cb)(int id);
+
+//Text-to-speech engine used by the screen reader.
+typedef struct _Ea_Tts_Backend
+{
+   const char *name;
+   //Create the engine and start preparing it. READY is notified by state_cb.
+   Eina_Bool (*init)(Ea_Tts_State_Changed_Cb state_cb, Ea_Tts_Completed_Cb completed_cb);
+   void (*shutdown)(void);
+   Ea_Tts_State (*state_get)(void);
+   Eina_Bool (*text_add)(const char *text, int *id);
+   Eina_Bool (*play)(void);
+   //Stop playing and drop the added texts.
+   void (*stop)(void);
+} Ea_Tts_Backend;
+
+const Ea_Tts_Backend *_ea_tts_backend_get(void);
+
+/* efl_assist_tts_local.c */
+extern const Ea_Tts_Backend _ea_tts_local_backend;
+
+/* efl_assist_text.c */
+void _ea_text_init(void);
+char *_ea_text_casefold(const char *str);
+void _ea_text_markup_escape_append(Eina_Strbuf *buf, const char *str, size_t len);
+void _ea_text_trim(void);
 
 #ifdef __cplusplus
 }
@@ -24,6 +24,32 @@
 extern "C" {
 #endif
 
+/**
+ * Priorities of the utterances said by ea_screen_reader_speak().
+ */
+typedef enum _Ea_Screen_Reader_Priority
+{
+   EA_SCREEN_READER_PRIORITY_LOW,    /**< Hints. Dropped first. */
+   EA_SCREEN_READER_PRIORITY_NORMAL, /**< Focus and navigation announcements. */
+   EA_SCREEN_READER_PRIORITY_HIGH    /**< Alerts. */
+} Ea_Screen_Reader_Priority;
+
+/**
+ * Flags of ea_screen_reader_speak().
+ */
+typedef enum _Ea_Screen_Reader_Speak_Flags
+{
+   EA_SCREEN_READER_SPEAK_INTERRUPT = (1 << 0) /**< Stop the utterance being said and the waiting ones of the same or lower priority. */
+} Ea_Screen_Reader_Speak_Flags;
+
+/**
+ * Called when the screen reader setting of the device is changed.
+ *
+ * @param data The data pointer passed to ea_screen_reader_changed_cb_add().
+ * @param enabled EINA_TRUE if the screen reader is turned on.
+ */
+typedef void (*Ea_Screen_Reader_Changed_Cb)(void *data, Eina_Bool enabled);
+
 /**
  * Set an application window property whether the application supports screen reader or not.
  *
@@ -34,7 +60,10 @@ extern "C" {
  * @param[in] support The property value that will set to the windonw(elm_win).
  *
  * @brief  This function sets an application window property which indicates the application
- *         supports screen reader or not.
+ *         supports screen reader or not. The support is kept per window. The access
+ *         mode of elementary stays on while at least one window supports screen
+ *         reader, and it is switched only when that changes. Setting the same
+ *         value again doesn't touch the window property.
  */
 EAPI Eina_Bool ea_screen_reader_support_set(Evas_Object *win, Eina_Bool support);
 
@@ -48,6 +77,71 @@ EAPI Eina_Bool ea_screen_reader_support_set(Evas_Object *win, Eina_Bool support)
  */
 EAPI Eina_Bool ea_screen_reader_support_get();
 
+/**
+ * Get whether a window supports screen reader.
+ *
+ * @return property The value set to the window by ea_screen_reader_support_set().
+ *
+ * @param[in] win The window(elm_win) object of the application.
+ */
+EAPI Eina_Bool ea_screen_reader_window_support_get(const Evas_Object *win);
+
+/**
+ * Get whether the screen reader is turned on in the device setting.
+ *
+ * @return EINA_TRUE if the screen reader is turned on.
+ *
+ * @brief  The setting is read once and then kept up to date by the change
+ *         notification of the setting, so this function doesn't block.
+ */
+EAPI Eina_Bool ea_screen_reader_enabled_get(void);
+
+/**
+ * Add a callback called when the screen reader setting is changed.
+ *
+ * @param[in] func The callback function.
+ * @param[in] data The data pointer to be passed to @p func.
+ *
+ * @see ea_screen_reader_changed_cb_del()
+ */
+EAPI void ea_screen_reader_changed_cb_add(Ea_Screen_Reader_Changed_Cb func, const void *data);
+
+/**
+ * Delete a callback added by ea_screen_reader_changed_cb_add().
+ *
+ * @return data The data pointer of the deleted callback.
+ *
+ * @param[in] func The callback function.
+ *
+ * @brief  If the callback was added more than once, the last added one is deleted.
+ */
+EAPI void *ea_screen_reader_changed_cb_del(Ea_Screen_Reader_Changed_Cb func);
+
+/**
+ * Say a text with the screen reader.
+ *
+ * @return ret EINA_TRUE if the text is said or queued.
+ *
+ * @param[in] text The text to say.
+ * @param[in] priority The priority of the text.
+ * @param[in] flags The bitwise OR of Ea_Screen_Reader_Speak_Flags.
+ *
+ * @brief  The texts are queued by priority and said one by one. Queuing a text
+ *         drops the waiting texts of lower priority, which are stale by then,
+ *         and a text which is already being said or waiting is not queued
+ *         again. Nothing is said when the screen reader is turned off.
+ *
+ * @see ea_screen_reader_speak_cancel()
+ */
+EAPI Eina_Bool ea_screen_reader_speak(const char *text, Ea_Screen_Reader_Priority priority, unsigned int flags);
+
+/**
+ * Stop the text being said and drop all waiting texts.
+ *
+ * @see ea_screen_reader_speak()
+ */
+EAPI void ea_screen_reader_speak_cancel(void);
+
 #ifdef __cplusplus
 }
 #endif
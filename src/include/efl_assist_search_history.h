@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_SEARCH_HISTORY_H__
+#define __EFL_ASSIST_SEARCH_HISTORY_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef Ea_Search_History
+ *
+ * A persistent store of recently searched texts.
+ *
+ * @see ea_search_history_open()
+ */
+typedef struct _Ea_Search_History Ea_Search_History;
+
+/**
+ * Open a search history store.
+ *
+ * @param[in] path The file that keeps the history.
+ * @param[in] max_count The maximum number of texts to keep. The least
+ *            recently used texts are dropped when the store is saved.
+ * @return    A new search history handle, or @c NULL on failure.
+ *
+ * @brief The history file is memory-mapped, it is not parsed on open and
+ *        lookups read it in place. Changes are kept in memory and written
+ *        back to @p path by a worker thread shortly after they are made.
+ *        A missing or corrupted file is treated as an empty history.
+ *
+ * @see ea_search_history_close()
+ */
+EAPI Ea_Search_History *ea_search_history_open(const char *path, unsigned int max_count);
+
+/**
+ * Close a search history store.
+ *
+ * @param[in] hist The search history handle.
+ *
+ * @brief Pending changes are written to the history file before the handle is
+ *        released. The handle must not be attached to any searchbar when it is
+ *        closed.
+ *
+ * @see ea_search_history_open()
+ */
+EAPI void ea_search_history_close(Ea_Search_History *hist);
+
+/**
+ * Add a text to the search history or mark it as the most recently used one.
+ *
+ * @param[in] hist The search history handle.
+ * @param[in] text The UTF-8 text to add.
+ */
+EAPI void ea_search_history_add(Ea_Search_History *hist, const char *text);
+
+/**
+ * Remove a text from the search history.
+ *
+ * @param[in] hist The search history handle.
+ * @param[in] text The UTF-8 text to remove. The case is ignored.
+ */
+EAPI void ea_search_history_remove(Ea_Search_History *hist, const char *text);
+
+/**
+ * Remove all texts from the search history.
+ *
+ * @param[in] hist The search history handle.
+ */
+EAPI void ea_search_history_clear(Ea_Search_History *hist);
+
+/**
+ * Find the texts in the search history that start with a prefix.
+ *
+ * @param[in] hist The search history handle.
+ * @param[in] prefix The UTF-8 prefix. The case is ignored. @c NULL or an empty
+ *            string matches all texts.
+ * @param[in] max_count The maximum number of texts to return.
+ * @return    A list of stringshared texts, the most recently used first.
+ *            The caller must release each text with eina_stringshare_del()
+ *            and free the list.
+ */
+EAPI Eina_List *ea_search_history_lookup(Ea_Search_History *hist, const char *prefix, unsigned int max_count);
+
+/**
+ * Attach a search history store to a searchbar editfield.
+ *
+ * @param[in] obj The editfield created with type EA_EDITFIELD_SEARCHBAR.
+ * @param[in] hist The search history handle, or @c NULL to detach.
+ *
+ * @brief The text of the searchbar is added to @p hist every time the
+ *        searchbar is activated (e.g. the search key of the input panel is
+ *        pressed). The same handle can be attached to several searchbars.
+ *
+ * @see ea_editfield_search_history_suggestions_get()
+ */
+EAPI void ea_editfield_search_history_set(Evas_Object *obj, Ea_Search_History *hist);
+
+/**
+ * Get the search history store attached to a searchbar editfield.
+ *
+ * @param[in] obj The editfield object.
+ * @return    The attached search history handle, or @c NULL.
+ */
+EAPI Ea_Search_History *ea_editfield_search_history_get(Evas_Object *obj);
+
+/**
+ * Get the suggestions for the current text of a searchbar editfield.
+ *
+ * @param[in] obj The editfield object.
+ * @param[in] max_count The maximum number of suggestions to return.
+ * @return    A list of stringshared texts as ea_search_history_lookup()
+ *            returns, or @c NULL if no history is attached.
+ */
+EAPI Eina_List *ea_editfield_search_history_suggestions_get(Evas_Object *obj, unsigned int max_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_SEARCH_HISTORY_H__ */
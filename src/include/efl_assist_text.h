@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef __EFL_ASSIST_TEXT_H__
+#define __EFL_ASSIST_TEXT_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Find the first case-insensitive occurrence of a string in a UTF-8 text.
+ *
+ * @param[in] str The UTF-8 text to search in.
+ * @param[in] query The UTF-8 string to search for.
+ * @param[out] len The length in bytes of the matched region of @p str.
+ *             Can be @c NULL.
+ * @return    A pointer to the first match inside @p str, or @c NULL if
+ *            @p query does not occur in @p str.
+ *
+ * @brief This function compares the texts with simple Unicode case folding
+ *        (ASCII, Latin-1, Latin Extended-A, Greek and Cyrillic letters).
+ *        Candidate positions are scanned with the fastest vector kernel
+ *        (AVX2, SSE2 or NEON) supported by the running CPU, so this can be
+ *        used for filtering large lists while the user is typing.
+ *        The matched region can be longer or shorter than @p query in bytes,
+ *        that is why its length is returned in @p len.
+ *        An empty @p query matches at the beginning of @p str.
+ *
+ * @see ea_text_match()
+ * @see ea_text_match_prefix()
+ */
+EAPI const char *ea_text_match_find(const char *str, const char *query, int *len);
+
+/**
+ * Check whether a UTF-8 text contains a string, ignoring the case.
+ *
+ * @param[in] str The UTF-8 text to search in.
+ * @param[in] query The UTF-8 string to search for.
+ * @return    EINA_TRUE if @p query occurs in @p str, EINA_FALSE otherwise.
+ *
+ * @brief This is the same as ea_text_match_find() but only reports whether
+ *        the text matches or not.
+ *
+ * @see ea_text_match_find()
+ */
+EAPI Eina_Bool ea_text_match(const char *str, const char *query);
+
+/**
+ * Check whether a UTF-8 text starts with a string, ignoring the case.
+ *
+ * @param[in] str The UTF-8 text to check.
+ * @param[in] prefix The UTF-8 prefix.
+ * @return    EINA_TRUE if @p str starts with @p prefix, EINA_FALSE otherwise.
+ *
+ * @see ea_text_match_find()
+ */
+EAPI Eina_Bool ea_text_match_prefix(const char *str, const char *prefix);
+
+/**
+ * Get the markup of a label with the matches of a query highlighted.
+ *
+ * @param[in] label The UTF-8 plain text label.
+ * @param[in] query The UTF-8 search query. Can be @c NULL.
+ * @return    The markup, which must be freed by the caller, or @c NULL on
+ *            failure.
+ *
+ * @brief The label is escaped for the markup and every case-insensitive
+ *        match of @p query, found as in ea_text_match_find(), is enclosed in
+ *        a \<match\> tag. The result is cached per label until the query
+ *        changes, so the text_get function of a filtered genlist can return
+ *        it directly and scrolling doesn't match and escape the labels again.
+ *
+ * @see ea_text_match_find()
+ */
+EAPI char *ea_text_highlight(const char *label, const char *query);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EFL_ASSIST_TEXT_H__ */
@@ -17,11 +17,27 @@
 
 #include "efl_assist.h"
 #include "efl_assist_private.h"
+#include <dlfcn.h>
 
 /*===========================================================================*
  *                                 Local                                     *
  *===========================================================================*/
 
+static Ea_Memory_Stats mem_stats[EA_MEMORY_TYPE_LAST];
+static app_event_handler_h low_memory_handler = NULL;
+static unsigned int magic_generation = 0;
+
+static const char *mem_type_names[EA_MEMORY_TYPE_LAST] = {
+	"event manager",
+	"object event",
+	"callback",
+	"object",
+	"editfield",
+	"tts",
+	"pool",
+	"page",
+};
+
 static const char *
 _magic_string_get(ea_magic m)
 {
@@ -32,19 +48,69 @@ _magic_string_get(ea_magic m)
 	case EA_MAGIC_CUTLINK:
 		return "cutlink";
 
+	case EA_MAGIC_EVENT_MGR:
+		return "Ea_Event_Mgr";
+
+	case EA_MAGIC_OBJECT_EVENT:
+		return "Ea_Object_Event";
+
+	case EA_MAGIC_EVENT_CALLBACK:
+		return "Ea_Event_Callback";
+
+	case EA_MAGIC_EDITFIELD:
+		return "Ea_Editfield_Data";
+
 	default:
 		return "<UNKNOWN>";
      }
 }
 
+static void
+_low_memory_cb(app_event_info_h event_info, void *data)
+{
+	app_event_low_memory_status_e status;
+
+	if (app_event_get_low_memory_status(event_info, &status) != APP_ERROR_NONE)
+		return;
+
+	if (status == APP_EVENT_LOW_MEMORY_HARD_WARNING)
+		ea_memory_trim(EA_MEMORY_TRIM_HARD);
+	else if (status == APP_EVENT_LOW_MEMORY_SOFT_WARNING)
+		ea_memory_trim(EA_MEMORY_TRIM_SOFT);
+}
+
 __CONSTRUCTOR__ static void
 ea_mod_init(void)
 {
+	int ret;
+
+	_ea_text_init();
+
+	ret = ui_app_add_event_handler(&low_memory_handler, APP_EVENT_LOW_MEMORY,
+				       _low_memory_cb, NULL);
+	if (ret != APP_ERROR_NONE) {
+		LOGW("Failed to add low memory handler: result(%d)", ret);
+		low_memory_handler = NULL;
+	}
 }
 
 __DESTRUCTOR__ static void
 ea_mod_shutdown(void)
 {
+	int i;
+
+	if (low_memory_handler) {
+		ui_app_remove_event_handler(low_memory_handler);
+		low_memory_handler = NULL;
+	}
+
+	_ea_screen_reader_shutdown();
+
+	for (i = 0; i < EA_MEMORY_TYPE_LAST; i++) {
+		if (!mem_stats[i].count) continue;
+		LOGW("Leak: %u %s record(s), %zu bytes",
+		     mem_stats[i].count, mem_type_names[i], mem_stats[i].bytes);
+	}
 }
 
 
@@ -67,11 +133,97 @@ _ea_magic_fail(const void *d, ea_magic m, ea_magic req_m, const char *fname)
 		    "    Supplied: %08x - %s",
 		    (unsigned int)req_m, _magic_string_get(req_m),
 		    (unsigned int)m, _magic_string_get(m));
+	else
+		LOGE("  Input handle has been freed and allocated again!");
 
    if (getenv("EA_ERROR_ABORT")) abort();
 }
 
+unsigned int
+_ea_magic_generation_next(void)
+{
+	return ++magic_generation;
+}
+
+/* Load a library on first use and resolve all its symbols. A library which
+ * failed once is not tried again. The library is kept loaded until the
+ * process exits. */
+Eina_Bool
+_ea_dl_load(Ea_Dl_Lib *lib)
+{
+	const Ea_Dl_Symbol *sym;
+	void *handle;
+
+	if (lib->handle) return EINA_TRUE;
+	if (lib->failed) return EINA_FALSE;
+
+	handle = dlopen(lib->soname, RTLD_NOW | RTLD_LOCAL);
+	if (!handle) {
+		LOGE("Failed to load %s: %s", lib->soname, dlerror());
+		lib->failed = EINA_TRUE;
+		return EINA_FALSE;
+	}
+
+	for (sym = lib->symbols; sym->name; sym++) {
+		*sym->func = dlsym(handle, sym->name);
+		if (!*sym->func) {
+			LOGE("Failed to find %s in %s", sym->name, lib->soname);
+			dlclose(handle);
+			lib->failed = EINA_TRUE;
+			return EINA_FALSE;
+		}
+	}
+
+	lib->handle = handle;
+	return EINA_TRUE;
+}
+
+void *
+_ea_mem_calloc(Ea_Memory_Type type, size_t size)
+{
+	void *ptr = calloc(1, size);
+
+	if (ptr) {
+		mem_stats[type].count++;
+		mem_stats[type].bytes += size;
+	}
+	return ptr;
+}
+
+void
+_ea_mem_free(Ea_Memory_Type type, void *ptr, size_t size)
+{
+	if (!ptr) return;
+
+	mem_stats[type].count--;
+	mem_stats[type].bytes -= size;
+	free(ptr);
+}
+
 /*===========================================================================*
  *                                  API                                      *
  *===========================================================================*/
 
+EXPORT_API Eina_Bool
+ea_memory_stats_get(Ea_Memory_Type type, Ea_Memory_Stats *stats)
+{
+	if (!stats) return EINA_FALSE;
+	if ((unsigned int)type >= EA_MEMORY_TYPE_LAST) return EINA_FALSE;
+
+	*stats = mem_stats[type];
+	return EINA_TRUE;
+}
+
+EXPORT_API void
+ea_memory_trim(Ea_Memory_Trim_Level level)
+{
+	_ea_editfield_preload_trim();
+	_ea_screen_reader_trim();
+	_ea_pool_trim();
+	_ea_naviframe_trim();
+	_ea_text_trim();
+
+	//Theme groups, images and fonts are shared with the application.
+	if (level == EA_MEMORY_TRIM_HARD)
+		elm_cache_all_flush();
+}
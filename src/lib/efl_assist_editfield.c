@@ -1,18 +1,77 @@
 #include "efl_assist.h"
 #include "efl_assist_private.h"
+#include <libintl.h>
 
-const char *EA_EF_KEY_DATA = "_ea_ef_key_data";
+#define EA_TEXT_DOMAIN "efl-assist"
 
-typedef struct _Ea_Editfield_Data
+//The English texts are the message ids. The labels set by the application
+//take their place.
+static const char *access_label_ids[EA_EDITFIELD_ACCESS_LABEL_LAST] =
 {
-   Eina_Bool clear_btn_disabled;
-} Ea_Editfield_Data;
+   "Clear text",
+   "Empty",
+   "Password"
+};
+static char *access_labels[EA_EDITFIELD_ACCESS_LABEL_LAST];
+
+static char *_editfield_access_label_get(Ea_Editfield_Access_Label label)
+{
+   if (access_labels[label]) return strdup(access_labels[label]);
+
+   return strdup(dgettext(EA_TEXT_DOMAIN, access_label_ids[label]));
+}
+
+static void _editfield_text_cache_clear(Ea_Editfield_Data *eed)
+{
+   if (!eed || !eed->text_utf8) return;
+   free(eed->text_utf8);
+   eed->text_utf8 = NULL;
+}
+
+//The access callbacks are called only when the screen reader highlights the
+//field, so nothing is built for the fields which are never read. The text
+//comes from the utf8 cache, which is kept until the next change.
+static char *_editfield_access_info_cb(void *data, Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+   const char *text;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return NULL;
+
+   //Never read out a password, only what the field is.
+   if (eed->type == EA_EDITFIELD_SCROLL_SINGLELINE_PASSWORD)
+     return _editfield_access_label_get(EA_EDITFIELD_ACCESS_LABEL_PASSWORD);
+
+   text = ea_editfield_text_utf8_get(obj);
+   if (text && text[0]) return strdup(text);
+
+   //Read the guide text of an empty field.
+   text = elm_object_part_text_get(obj, "elm.guide");
+   if (text && text[0]) return elm_entry_markup_to_utf8(text);
+
+   return NULL;
+}
+
+static char *_editfield_access_state_cb(void *data, Evas_Object *obj)
+{
+   if (elm_entry_is_empty(obj))
+     return _editfield_access_label_get(EA_EDITFIELD_ACCESS_LABEL_EMPTY);
+
+   return NULL;
+}
+
+static char *_eraser_btn_access_info_cb(void *data, Evas_Object *obj)
+{
+   return _editfield_access_label_get(EA_EDITFIELD_ACCESS_LABEL_CLEAR);
+}
 
 static void _editfield_changed_cb(void *data, Evas_Object *obj, void *event_info)
 {
    Ea_Editfield_Data *eed;
 
-   eed = (Ea_Editfield_Data *)evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
+   _editfield_text_cache_clear(eed);
    if (eed && !(eed->clear_btn_disabled)
        && elm_object_part_content_get(obj, "elm.swallow.clear"))
      {
@@ -30,7 +89,7 @@ static void _editfield_focused_cb(void *data, Evas_Object *obj, void *event_info
 {
    Ea_Editfield_Data *eed;
 
-   eed = (Ea_Editfield_Data *)evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
    if (eed && !(eed->clear_btn_disabled)
        && elm_object_part_content_get(obj, "elm.swallow.clear"))
      {
@@ -46,7 +105,7 @@ static void _editfield_unfocused_cb(void *data, Evas_Object *obj, void *event_in
 {
    Ea_Editfield_Data *eed;
 
-   eed = (Ea_Editfield_Data *)evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
    if (eed && !(eed->clear_btn_disabled)
        && elm_object_part_content_get(obj, "elm.swallow.clear"))
      elm_object_signal_emit(obj, "elm,state,clear,hidden", "");
@@ -55,14 +114,27 @@ static void _editfield_unfocused_cb(void *data, Evas_Object *obj, void *event_in
 
 static void _eraser_btn_clicked_cb(void *data, Evas_Object *obj, void *event_info)
 {
+   ea_editfield_text_load_cancel(data);
    elm_entry_entry_set(data, "");
 }
 
+static void _editfield_data_free(Ea_Editfield_Data *eed)
+{
+   _ea_editfield_load_free(eed);
+   _ea_editfield_filter_free(eed);
+   _ea_editfield_history_free(eed);
+   _ea_editfield_focus_free(eed);
+   _editfield_text_cache_clear(eed);
+   EA_MAGIC_SET(eed, EA_MAGIC_NONE);
+   _ea_mem_free(EA_MEMORY_EDITFIELD, eed, sizeof(Ea_Editfield_Data));
+}
+
 static void _editfield_searchbar_changed_cb(void *data, Evas_Object *obj, void *event_info)
 {
    Ea_Editfield_Data *eed;
 
-   eed = (Ea_Editfield_Data *)evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
+   _editfield_text_cache_clear(eed);
    if (eed && !(eed->clear_btn_disabled)
        && elm_object_part_content_get(obj, "elm.swallow.clear"))
      {
@@ -88,6 +160,7 @@ ea_editfield_add(Evas_Object *parent, Ea_Editfield_Type type)
 {
    Evas_Object *entry, *button;
    Ea_Editfield_Data *eed;
+   Ea_Object_Data *od;
 
    entry = elm_entry_add(parent);
 
@@ -136,6 +209,7 @@ ea_editfield_add(Evas_Object *parent, Ea_Editfield_Type type)
         elm_object_focus_allow_set(button, EINA_FALSE);
         elm_object_part_content_set(entry, "elm.swallow.clear", button);
         evas_object_smart_callback_add(button, "clicked", _eraser_btn_clicked_cb, entry);
+        elm_access_info_cb_set(button, ELM_ACCESS_INFO, _eraser_btn_access_info_cb, NULL);
 
         evas_object_smart_callback_add(entry, "changed", _editfield_searchbar_changed_cb, NULL);
         evas_object_smart_callback_add(entry, "preedit,changed", _editfield_searchbar_changed_cb, NULL);
@@ -149,6 +223,7 @@ ea_editfield_add(Evas_Object *parent, Ea_Editfield_Type type)
         elm_object_focus_allow_set(button, EINA_FALSE);
         elm_object_part_content_set(entry, "elm.swallow.clear", button);
         evas_object_smart_callback_add(button, "clicked", _eraser_btn_clicked_cb, entry);
+        elm_access_info_cb_set(button, ELM_ACCESS_INFO, _eraser_btn_access_info_cb, NULL);
 
         evas_object_smart_callback_add(entry, "changed", _editfield_changed_cb, NULL);
         evas_object_smart_callback_add(entry, "preedit,changed", _editfield_changed_cb, NULL);
@@ -156,9 +231,23 @@ ea_editfield_add(Evas_Object *parent, Ea_Editfield_Type type)
         evas_object_smart_callback_add(entry, "unfocused", _editfield_unfocused_cb, NULL);
      }
 
-   eed = calloc(1, sizeof(Ea_Editfield_Data));
+   od = _ea_object_data_add(entry);
+   if (!od) return entry;
+
+   eed = _ea_mem_calloc(EA_MEMORY_EDITFIELD, sizeof(Ea_Editfield_Data));
+   if (!eed)
+     {
+        LOGE("Failed to allocate editfield data");
+        _ea_object_data_release(od);
+        return entry;
+     }
+   EA_MAGIC_SET(eed, EA_MAGIC_EDITFIELD);
    eed->clear_btn_disabled = EINA_FALSE;
-   evas_object_data_set(entry, EA_EF_KEY_DATA, eed);
+   eed->type = type;
+   od->eed = eed;
+
+   elm_access_info_cb_set(entry, ELM_ACCESS_INFO, _editfield_access_info_cb, NULL);
+   elm_access_info_cb_set(entry, ELM_ACCESS_STATE, _editfield_access_state_cb, NULL);
    return entry;
 }
 
@@ -167,7 +256,7 @@ ea_editfield_clear_button_disabled_set(Evas_Object *obj, Eina_Bool disable)
 {
    Ea_Editfield_Data *eed;
 
-   eed = evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
    if (eed)
      {
         eed->clear_btn_disabled = !!disable;
@@ -183,9 +272,59 @@ ea_editfield_clear_button_disabled_get(Evas_Object *obj)
 
    if (!obj)
      return EINA_FALSE;
-   eed = evas_object_data_get(obj, EA_EF_KEY_DATA);
+   eed = _ea_editfield_data_get(obj);
    if (!eed)
      return EINA_FALSE;
 
    return eed->clear_btn_disabled;
 }
+
+EXPORT_API void
+ea_editfield_access_label_set(Ea_Editfield_Access_Label label, const char *text)
+{
+   if ((unsigned int)label >= EA_EDITFIELD_ACCESS_LABEL_LAST) return;
+
+   free(access_labels[label]);
+   access_labels[label] = text ? strdup(text) : NULL;
+}
+
+EXPORT_API const char *
+ea_editfield_text_utf8_get(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+
+   if (!obj)
+     return NULL;
+   eed = _ea_editfield_data_get(obj);
+   if (!eed)
+     return NULL;
+
+   if (!eed->text_utf8)
+     eed->text_utf8 = elm_entry_markup_to_utf8(elm_entry_entry_get(obj));
+
+   return eed->text_utf8;
+}
+
+Ea_Editfield_Data *
+_ea_editfield_data_get(const Evas_Object *obj)
+{
+   Ea_Object_Data *od = _ea_object_data_get(obj);
+
+   if (!od || !od->eed) return NULL;
+   if (!EA_MAGIC_CHECK(od->eed, EA_MAGIC_EDITFIELD))
+     {
+        EA_MAGIC_FAIL(od->eed, EA_MAGIC_EDITFIELD, __func__);
+        return NULL;
+     }
+
+   return od->eed;
+}
+
+void
+_ea_editfield_object_del(Ea_Object_Data *od)
+{
+   Ea_Editfield_Data *eed = od->eed;
+
+   od->eed = NULL;
+   _editfield_data_free(eed);
+}
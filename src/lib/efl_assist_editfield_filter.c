@@ -0,0 +1,370 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+typedef struct _Ea_Charset_Range
+{
+   Eina_Unicode start;
+   Eina_Unicode end;
+} Ea_Charset_Range;
+
+struct _Ea_Editfield_Charset
+{
+   int ref;
+   unsigned int ascii[4];       //bitmap of U+0000 ~ U+007F
+   Ea_Charset_Range *ranges;    //sorted, not overlapped ranges above U+007F
+   unsigned int range_count;
+};
+
+struct _Ea_Editfield_Filter_Data
+{
+   Ea_Editfield_Charset *accepted;
+   int max_char_count;
+   int max_byte_count;
+   int char_count;
+   int byte_count;
+   Eina_Bool stale : 1;         //counts don't reflect the text
+   Eina_Bool unconfirmed : 1;   //"changed" came, waiting for "changed,user"
+};
+
+static int
+_ea_charset_range_cmp(const void *data1, const void *data2)
+{
+   const Ea_Charset_Range *range = data1;
+   const Ea_Charset_Range *range2 = data2;
+
+   if (range->start == range2->start) return 0;
+   return (range->start < range2->start) ? -1 : 1;
+}
+
+static Eina_Bool
+_ea_charset_contains(const Ea_Editfield_Charset *charset, Eina_Unicode c)
+{
+   unsigned int lo = 0, hi = charset->range_count, mid;
+
+   if (c < 0x80)
+     return !!(charset->ascii[c >> 5] & (1U << (c & 31)));
+
+   while (lo < hi)
+     {
+        mid = lo + (hi - lo) / 2;
+        if (c < charset->ranges[mid].start) hi = mid;
+        else if (c > charset->ranges[mid].end) lo = mid + 1;
+        else return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+static void
+_ea_charset_unref(Ea_Editfield_Charset *charset)
+{
+   if (!charset) return;
+   if (--charset->ref > 0) return;
+
+   free(charset->ranges);
+   free(charset);
+}
+
+static void
+_ea_text_measure(const char *utf8, int *chars, int *bytes)
+{
+   const unsigned char *s = (const unsigned char *) utf8;
+   int n = 0;
+
+   *bytes = 0;
+   *chars = 0;
+   if (!s) return;
+
+   for (; s[n]; n++)
+     {
+        if ((s[n] & 0xC0) != 0x80) (*chars)++;
+     }
+   *bytes = n;
+}
+
+static void
+_ea_markup_measure(const char *markup, int *chars, int *bytes)
+{
+   char *utf8;
+
+   utf8 = elm_entry_markup_to_utf8(markup);
+   _ea_text_measure(utf8, chars, bytes);
+   free(utf8);
+}
+
+static void
+_ea_editfield_filter_count_update(Evas_Object *obj, Ea_Editfield_Filter_Data *fd)
+{
+   if (!fd->stale) return;
+
+   _ea_text_measure(ea_editfield_text_utf8_get(obj), &fd->char_count, &fd->byte_count);
+   fd->stale = EINA_FALSE;
+   fd->unconfirmed = EINA_FALSE;
+}
+
+static void
+_ea_editfield_filter_cb(void *data, Evas_Object *obj, char **text)
+{
+   Ea_Editfield_Filter_Data *fd = data;
+   Eina_Strbuf *buf;
+   Eina_Unicode c;
+   char *utf8;
+   int chars, bytes, prev, idx = 0;
+   Eina_Bool dropped = EINA_FALSE;
+
+   if (!*text || !**text) return;
+
+   _ea_editfield_filter_count_update(obj, fd);
+
+   utf8 = elm_entry_markup_to_utf8(*text);
+   if (!utf8) return;
+
+   buf = eina_strbuf_new();
+   if (!buf)
+     {
+        free(utf8);
+        return;
+     }
+
+   chars = fd->char_count;
+   bytes = fd->byte_count;
+   while (utf8[idx])
+     {
+        prev = idx;
+        c = eina_unicode_utf8_next_get(utf8, &idx);
+        if (fd->accepted && !_ea_charset_contains(fd->accepted, c))
+          {
+             dropped = EINA_TRUE;
+             continue;
+          }
+        if ((fd->max_char_count && (chars + 1 > fd->max_char_count)) ||
+            (fd->max_byte_count && (bytes + idx - prev > fd->max_byte_count)))
+          {
+             dropped = EINA_TRUE;
+             break;
+          }
+        eina_strbuf_append_length(buf, utf8 + prev, idx - prev);
+        chars++;
+        bytes += idx - prev;
+     }
+   free(utf8);
+
+   if (dropped)
+     {
+        free(*text);
+        if (eina_strbuf_length_get(buf))
+          *text = elm_entry_utf8_to_markup(eina_strbuf_string_get(buf));
+        else
+          *text = NULL;
+     }
+   eina_strbuf_free(buf);
+}
+
+static void
+_ea_editfield_filter_changed_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_Filter_Data *fd = data;
+
+   //Programmatic changes have no change info. Count again at the next use.
+   if (fd->stale) return;
+   fd->stale = EINA_TRUE;
+   fd->unconfirmed = EINA_TRUE;
+}
+
+static void
+_ea_editfield_filter_changed_user_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_Filter_Data *fd = data;
+   Elm_Entry_Change_Info *info = event_info;
+   int chars, bytes;
+
+   if (!fd->unconfirmed || !info) return;
+
+   if (info->insert)
+     {
+        _ea_markup_measure(info->change.insert.content, &chars, &bytes);
+        fd->char_count += chars;
+        fd->byte_count += bytes;
+     }
+   else
+     {
+        _ea_markup_measure(info->change.del.content, &chars, &bytes);
+        fd->char_count -= chars;
+        fd->byte_count -= bytes;
+     }
+
+   fd->stale = EINA_FALSE;
+   fd->unconfirmed = EINA_FALSE;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_editfield_filter_free(Ea_Editfield_Data *eed)
+{
+   if (!eed->filter) return;
+
+   _ea_charset_unref(eed->filter->accepted);
+   free(eed->filter);
+   eed->filter = NULL;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Ea_Editfield_Charset *
+ea_editfield_charset_new(const char *spec)
+{
+   Ea_Editfield_Charset *charset;
+   Ea_Charset_Range *ranges = NULL, *tmp;
+   Eina_Unicode c, end;
+   unsigned int count = 0, alloc = 0, i, j;
+   int idx = 0, next;
+
+   if (!spec) return NULL;
+
+   charset = calloc(1, sizeof(Ea_Editfield_Charset));
+   if (!charset)
+     {
+        LOGE("Failed to allocate charset");
+        return NULL;
+     }
+   charset->ref = 1;
+
+   while (spec[idx])
+     {
+        c = eina_unicode_utf8_next_get(spec, &idx);
+        if ((c == '\\') && spec[idx])
+          c = eina_unicode_utf8_next_get(spec, &idx);
+
+        end = c;
+        if ((spec[idx] == '-') && spec[idx + 1])
+          {
+             next = idx + 1;
+             end = eina_unicode_utf8_next_get(spec, &next);
+             if ((end == '\\') && spec[next])
+               end = eina_unicode_utf8_next_get(spec, &next);
+             idx = next;
+             if (end < c)
+               {
+                  Eina_Unicode t = c;
+                  c = end;
+                  end = t;
+               }
+          }
+
+        //ASCII part goes to the bitmap.
+        for (; (c <= end) && (c < 0x80); c++)
+          charset->ascii[c >> 5] |= 1U << (c & 31);
+        if (c > end) continue;
+
+        if (count == alloc)
+          {
+             alloc = alloc ? alloc * 2 : 8;
+             tmp = realloc(ranges, sizeof(Ea_Charset_Range) * alloc);
+             if (!tmp)
+               {
+                  LOGE("Failed to allocate charset");
+                  free(ranges);
+                  free(charset);
+                  return NULL;
+               }
+             ranges = tmp;
+          }
+        ranges[count].start = c;
+        ranges[count].end = end;
+        count++;
+     }
+
+   //Merge the overlapped ranges for the binary search.
+   if (count)
+     {
+        qsort(ranges, count, sizeof(Ea_Charset_Range), _ea_charset_range_cmp);
+        for (i = 0, j = 1; j < count; j++)
+          {
+             if (ranges[j].start <= ranges[i].end + 1)
+               {
+                  if (ranges[j].end > ranges[i].end)
+                    ranges[i].end = ranges[j].end;
+               }
+             else
+               ranges[++i] = ranges[j];
+          }
+        count = i + 1;
+     }
+
+   charset->ranges = ranges;
+   charset->range_count = count;
+
+   return charset;
+}
+
+EXPORT_API void
+ea_editfield_charset_free(Ea_Editfield_Charset *charset)
+{
+   _ea_charset_unref(charset);
+}
+
+EXPORT_API void
+ea_editfield_filter_set(Evas_Object *obj, const Ea_Editfield_Filter *filter)
+{
+   Ea_Editfield_Data *eed;
+   Ea_Editfield_Filter_Data *fd;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return;
+
+   if (!filter)
+     {
+        if (!eed->filter) return;
+        elm_entry_markup_filter_remove(obj, _ea_editfield_filter_cb, eed->filter);
+        evas_object_smart_callback_del(obj, "changed",
+                                       _ea_editfield_filter_changed_cb);
+        evas_object_smart_callback_del(obj, "changed,user",
+                                       _ea_editfield_filter_changed_user_cb);
+        _ea_editfield_filter_free(eed);
+        return;
+     }
+
+   fd = eed->filter;
+   if (!fd)
+     {
+        fd = calloc(1, sizeof(Ea_Editfield_Filter_Data));
+        if (!fd)
+          {
+             LOGE("Failed to allocate editfield filter");
+             return;
+          }
+        fd->stale = EINA_TRUE;
+        eed->filter = fd;
+        elm_entry_markup_filter_append(obj, _ea_editfield_filter_cb, fd);
+        evas_object_smart_callback_add(obj, "changed",
+                                       _ea_editfield_filter_changed_cb, fd);
+        evas_object_smart_callback_add(obj, "changed,user",
+                                       _ea_editfield_filter_changed_user_cb, fd);
+     }
+
+   if (filter->accepted) filter->accepted->ref++;
+   _ea_charset_unref(fd->accepted);
+   fd->accepted = filter->accepted;
+   fd->max_char_count = (filter->max_char_count > 0) ? filter->max_char_count : 0;
+   fd->max_byte_count = (filter->max_byte_count > 0) ? filter->max_byte_count : 0;
+}
+
+EXPORT_API int
+ea_editfield_filter_remaining_get(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+   int remaining;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->filter || !eed->filter->max_char_count) return -1;
+
+   _ea_editfield_filter_count_update(obj, eed->filter);
+   remaining = eed->filter->max_char_count - eed->filter->char_count;
+
+   return (remaining > 0) ? remaining : 0;
+}
@@ -0,0 +1,191 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+/* The fields of a chain point to their neighbours, so a hop costs the same
+ * on any form size and doesn't walk the focus tree of the window. */
+struct _Ea_Editfield_Focus
+{
+   Evas_Object *obj;
+   Ea_Editfield_Focus *prev;
+   Ea_Editfield_Focus *next;
+};
+
+static void
+_ea_editfield_focus_return_key_update(Ea_Editfield_Focus *f)
+{
+   elm_entry_input_panel_return_key_type_set(f->obj, f->next ?
+                                             ELM_INPUT_PANEL_RETURN_KEY_TYPE_NEXT :
+                                             ELM_INPUT_PANEL_RETURN_KEY_TYPE_DONE);
+}
+
+static Eina_Bool
+_ea_editfield_focus_hop(Ea_Editfield_Focus *to)
+{
+   if (!to) return EINA_FALSE;
+
+   //Focus the next field before the current one loses it. Both happen in
+   //this main loop iteration, so the input panel stays up.
+   elm_object_focus_set(to->obj, EINA_TRUE);
+   elm_entry_input_panel_show(to->obj);
+
+   return EINA_TRUE;
+}
+
+static void
+_ea_editfield_focus_activated_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_Focus *f = data;
+
+   _ea_editfield_focus_hop(f->next);
+}
+
+//Take the field out of its chain and join its neighbours.
+static void
+_ea_editfield_focus_unlink(Ea_Editfield_Focus *f)
+{
+   if (f->prev)
+     {
+        f->prev->next = f->next;
+        _ea_editfield_focus_return_key_update(f->prev);
+     }
+   if (f->next) f->next->prev = f->prev;
+   f->prev = NULL;
+   f->next = NULL;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_editfield_focus_free(Ea_Editfield_Data *eed)
+{
+   Ea_Editfield_Focus *f = eed->focus;
+
+   if (!f) return;
+
+   _ea_editfield_focus_unlink(f);
+   evas_object_smart_callback_del_full(f->obj, "activated",
+                                       _ea_editfield_focus_activated_cb, f);
+   free(f);
+   eed->focus = NULL;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Eina_Bool
+ea_editfield_focus_chain_set(Evas_Object **fields, unsigned int count)
+{
+   Ea_Editfield_Data *eed;
+   Ea_Editfield_Focus *f, *prev = NULL;
+   unsigned int i, j;
+
+   if (!fields || !count) return EINA_FALSE;
+
+   //Check all fields first, so a bad one doesn't leave half a chain.
+   for (i = 0; i < count; i++)
+     {
+        if (!_ea_editfield_data_get(fields[i]))
+          {
+             LOGW("The object(%p) is not an editfield", fields[i]);
+             return EINA_FALSE;
+          }
+        for (j = 0; j < i; j++)
+          {
+             if (fields[j] != fields[i]) continue;
+             LOGW("The editfield(%p) is in the chain twice", fields[i]);
+             return EINA_FALSE;
+          }
+     }
+
+   //Allocate before any link changes. The new ones have no object yet.
+   for (i = 0; i < count; i++)
+     {
+        eed = _ea_editfield_data_get(fields[i]);
+        if (eed->focus) continue;
+
+        eed->focus = calloc(1, sizeof(Ea_Editfield_Focus));
+        if (eed->focus) continue;
+
+        LOGE("Failed to allocate editfield focus");
+        for (j = 0; j < i; j++)
+          {
+             eed = _ea_editfield_data_get(fields[j]);
+             if (eed->focus->obj) continue;
+             free(eed->focus);
+             eed->focus = NULL;
+          }
+        return EINA_FALSE;
+     }
+
+   //Take all fields out of their old chains before linking the new one.
+   for (i = 0; i < count; i++)
+     {
+        f = _ea_editfield_data_get(fields[i])->focus;
+        if (f->obj)
+          {
+             _ea_editfield_focus_unlink(f);
+             continue;
+          }
+        f->obj = fields[i];
+        evas_object_smart_callback_add(f->obj, "activated",
+                                       _ea_editfield_focus_activated_cb, f);
+     }
+
+   for (i = 0; i < count; i++)
+     {
+        f = _ea_editfield_data_get(fields[i])->focus;
+        f->prev = prev;
+        if (prev)
+          {
+             prev->next = f;
+             _ea_editfield_focus_return_key_update(prev);
+          }
+        prev = f;
+     }
+   _ea_editfield_focus_return_key_update(prev);
+
+   return EINA_TRUE;
+}
+
+EXPORT_API void
+ea_editfield_focus_chain_unset(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->focus) return;
+
+   elm_entry_input_panel_return_key_type_set(obj, ELM_INPUT_PANEL_RETURN_KEY_TYPE_DEFAULT);
+   _ea_editfield_focus_free(eed);
+}
+
+EXPORT_API Evas_Object *
+ea_editfield_focus_chain_get(const Evas_Object *obj, Elm_Focus_Direction dir)
+{
+   Ea_Editfield_Data *eed;
+   Ea_Editfield_Focus *f;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->focus) return NULL;
+
+   f = (dir == ELM_FOCUS_PREVIOUS) ? eed->focus->prev : eed->focus->next;
+
+   return f ? f->obj : NULL;
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_focus_move(Evas_Object *obj, Elm_Focus_Direction dir)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->focus) return EINA_FALSE;
+
+   if (dir == ELM_FOCUS_PREVIOUS)
+     return _ea_editfield_focus_hop(eed->focus->prev);
+
+   return _ea_editfield_focus_hop(eed->focus->next);
+}
@@ -0,0 +1,334 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+#define EA_EDITFIELD_HISTORY_LIMIT (64 * 1024)
+
+/* The changed texts are appended to one buffer (the "add" buffer of a piece
+ * table) and the steps refer to them by offset, so a step costs a few words
+ * besides its own text. */
+typedef struct _Ea_Edit_Step
+{
+   size_t pos;       //cursor position of the change
+   size_t len;       //length of the change in cursor positions
+   size_t offset;    //markup of the change in the buffer, NUL terminated
+   size_t size;
+   Eina_Bool insert : 1;
+   Eina_Bool merge : 1;   //undone together with the previous step
+} Ea_Edit_Step;
+
+struct _Ea_Editfield_History
+{
+   Evas_Object *obj;
+   Eina_Strbuf *buf;
+   Ea_Edit_Step *steps;
+   unsigned int first;     //oldest step kept
+   unsigned int current;   //steps before this are applied
+   unsigned int count;
+   unsigned int alloc;
+   size_t limit;
+   Eina_Bool on_change : 1;     //undo or redo is running
+   Eina_Bool unconfirmed : 1;   //"changed" came, waiting for "changed,user"
+};
+
+static void
+_ea_editfield_history_reset(Ea_Editfield_History *h)
+{
+   eina_strbuf_reset(h->buf);
+   h->first = 0;
+   h->current = 0;
+   h->count = 0;
+}
+
+static void
+_ea_editfield_history_redo_drop(Ea_Editfield_History *h)
+{
+   if (h->current == h->count) return;
+
+   eina_strbuf_remove(h->buf, h->steps[h->current].offset,
+                      eina_strbuf_length_get(h->buf));
+   h->count = h->current;
+}
+
+//Drop the oldest steps over the limit and reclaim their space. The redo
+//steps must be dropped before, the undone ones are not counted as applied.
+static void
+_ea_editfield_history_trim(Ea_Editfield_History *h)
+{
+   size_t base;
+   unsigned int i;
+
+   while ((h->first < h->count) &&
+          (eina_strbuf_length_get(h->buf) - h->steps[h->first].offset > h->limit))
+     h->first++;
+
+   if (h->first == h->count)
+     {
+        _ea_editfield_history_reset(h);
+        return;
+     }
+
+   base = h->steps[h->first].offset;
+   if (base < (eina_strbuf_length_get(h->buf) / 2)) return;
+
+   eina_strbuf_remove(h->buf, 0, base);
+   for (i = h->first; i < h->count; i++)
+     {
+        h->steps[i - h->first] = h->steps[i];
+        h->steps[i - h->first].offset -= base;
+     }
+   h->count -= h->first;
+   h->current -= h->first;
+   h->first = 0;
+}
+
+static void
+_ea_editfield_history_record(Ea_Editfield_History *h, Eina_Bool insert,
+                             Eina_Bool merge, size_t pos, size_t len,
+                             const char *content)
+{
+   Ea_Edit_Step *steps, *step;
+   unsigned int alloc;
+
+   if (!content) return;
+
+   //A new edit drops the redo steps.
+   _ea_editfield_history_redo_drop(h);
+
+   if (h->count == h->alloc)
+     {
+        alloc = h->alloc ? h->alloc * 2 : 32;
+        steps = realloc(h->steps, sizeof(Ea_Edit_Step) * alloc);
+        if (!steps)
+          {
+             LOGE("Failed to allocate editfield history");
+             _ea_editfield_history_reset(h);
+             return;
+          }
+        h->steps = steps;
+        h->alloc = alloc;
+     }
+
+   step = h->steps + h->count;
+   step->pos = pos;
+   step->len = len;
+   step->offset = eina_strbuf_length_get(h->buf);
+   step->size = strlen(content);
+   step->insert = !!insert;
+   step->merge = (h->count > h->first) && merge &&
+      (h->steps[h->count - 1].insert == step->insert);
+   eina_strbuf_append_length(h->buf, content, step->size + 1);
+   h->count++;
+   h->current = h->count;
+
+   _ea_editfield_history_trim(h);
+}
+
+//Go through the entry like an insert does, so the entry updates its own
+//state and signals the change itself.
+static void
+_ea_editfield_history_range_delete(Evas_Object *obj, size_t pos, size_t len)
+{
+   elm_entry_select_region_set(obj, pos, pos + len);
+   elm_entry_entry_insert(obj, "");
+   elm_entry_select_none(obj);
+}
+
+static void
+_ea_editfield_history_insert(Ea_Editfield_History *h, const Ea_Edit_Step *step)
+{
+   elm_entry_cursor_pos_set(h->obj, step->pos);
+   elm_entry_entry_insert(h->obj, eina_strbuf_string_get(h->buf) + step->offset);
+}
+
+static void
+_ea_editfield_history_step_apply(Ea_Editfield_History *h,
+                                 const Ea_Edit_Step *step, Eina_Bool undo)
+{
+   h->on_change = EINA_TRUE;
+   if (step->insert == undo)
+     _ea_editfield_history_range_delete(h->obj, step->pos, step->len);
+   else
+     _ea_editfield_history_insert(h, step);
+   h->on_change = EINA_FALSE;
+}
+
+static void
+_ea_editfield_history_changed_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_History *h = data;
+
+   if (h->on_change) return;
+
+   //The previous change had no change info. It was made by the application
+   //and the recorded positions are not reliable anymore.
+   if (h->unconfirmed) _ea_editfield_history_reset(h);
+   h->unconfirmed = EINA_TRUE;
+}
+
+static void
+_ea_editfield_history_changed_user_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_History *h = data;
+   Elm_Entry_Change_Info *info = event_info;
+
+   if (h->on_change) return;
+   h->unconfirmed = EINA_FALSE;
+   if (!info) return;
+
+   if (info->insert)
+     _ea_editfield_history_record(h, EINA_TRUE, info->merge,
+                                  info->change.insert.pos,
+                                  info->change.insert.plain_length,
+                                  info->change.insert.content);
+   else
+     _ea_editfield_history_record(h, EINA_FALSE, info->merge,
+                                  MIN(info->change.del.start, info->change.del.end),
+                                  MAX(info->change.del.start, info->change.del.end) -
+                                  MIN(info->change.del.start, info->change.del.end),
+                                  info->change.del.content);
+}
+
+static Ea_Editfield_History *
+_ea_editfield_history_get(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+   Ea_Editfield_History *h;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->history) return NULL;
+
+   h = eed->history;
+   if (h->unconfirmed)
+     {
+        _ea_editfield_history_reset(h);
+        h->unconfirmed = EINA_FALSE;
+     }
+   return h;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_editfield_history_free(Ea_Editfield_Data *eed)
+{
+   Ea_Editfield_History *h = eed->history;
+
+   if (!h) return;
+
+   evas_object_smart_callback_del_full(h->obj, "changed",
+                                       _ea_editfield_history_changed_cb, h);
+   evas_object_smart_callback_del_full(h->obj, "changed,user",
+                                       _ea_editfield_history_changed_user_cb, h);
+   eina_strbuf_free(h->buf);
+   free(h->steps);
+   free(h);
+   eed->history = NULL;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API void
+ea_editfield_history_enabled_set(Evas_Object *obj, Eina_Bool enabled)
+{
+   Ea_Editfield_Data *eed;
+   Ea_Editfield_History *h;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return;
+
+   if (!enabled)
+     {
+        _ea_editfield_history_free(eed);
+        return;
+     }
+   if (eed->history) return;
+
+   h = calloc(1, sizeof(Ea_Editfield_History));
+   if (!h)
+     {
+        LOGE("Failed to allocate editfield history");
+        return;
+     }
+   h->buf = eina_strbuf_new();
+   if (!h->buf)
+     {
+        LOGE("Failed to allocate editfield history");
+        free(h);
+        return;
+     }
+   h->obj = obj;
+   h->limit = EA_EDITFIELD_HISTORY_LIMIT;
+   eed->history = h;
+
+   evas_object_smart_callback_add(obj, "changed",
+                                  _ea_editfield_history_changed_cb, h);
+   evas_object_smart_callback_add(obj, "changed,user",
+                                  _ea_editfield_history_changed_user_cb, h);
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_history_enabled_get(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return EINA_FALSE;
+
+   return !!eed->history;
+}
+
+EXPORT_API void
+ea_editfield_history_limit_set(Evas_Object *obj, size_t size)
+{
+   Ea_Editfield_History *h;
+
+   h = _ea_editfield_history_get(obj);
+   if (!h) return;
+
+   h->limit = size;
+   //Keep the undo steps, the redo ones may not fit in the new limit.
+   _ea_editfield_history_redo_drop(h);
+   _ea_editfield_history_trim(h);
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_undo(Evas_Object *obj)
+{
+   Ea_Editfield_History *h;
+   Ea_Edit_Step *step;
+
+   h = _ea_editfield_history_get(obj);
+   if (!h || (h->current == h->first)) return EINA_FALSE;
+
+   do
+     {
+        h->current--;
+        step = h->steps + h->current;
+        _ea_editfield_history_step_apply(h, step, EINA_TRUE);
+     }
+   while (step->merge && (h->current > h->first));
+
+   return EINA_TRUE;
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_redo(Evas_Object *obj)
+{
+   Ea_Editfield_History *h;
+
+   h = _ea_editfield_history_get(obj);
+   if (!h || (h->current == h->count)) return EINA_FALSE;
+
+   do
+     {
+        _ea_editfield_history_step_apply(h, h->steps + h->current, EINA_FALSE);
+        h->current++;
+     }
+   while ((h->current < h->count) && h->steps[h->current].merge);
+
+   return EINA_TRUE;
+}
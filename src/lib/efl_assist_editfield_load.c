@@ -0,0 +1,240 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//Source bytes appended per idler call.
+#define EA_EDITFIELD_LOAD_CHUNK (32 * 1024)
+
+struct _Ea_Editfield_Load
+{
+   Evas_Object *obj;
+   const char *src;
+   size_t total;
+   size_t loaded;
+   void *map;
+   char *copy;
+   Eina_Strbuf *buf;
+   Ecore_Idler *idler;
+   Ea_Editfield_Load_Cb func;
+   void *data;
+   Eina_Bool on_callback : 1;
+   Eina_Bool delete_me : 1;
+};
+
+static void
+_ea_editfield_load_del(Ea_Editfield_Load *load)
+{
+   if (load->idler) ecore_idler_del(load->idler);
+   if (load->map) munmap(load->map, load->total);
+   free(load->copy);
+   if (load->buf) eina_strbuf_free(load->buf);
+   free(load);
+}
+
+static Eina_Bool
+_ea_editfield_load_idler_cb(void *data)
+{
+   Ea_Editfield_Load *load = data;
+   Ea_Editfield_Data *eed;
+   size_t len;
+
+   len = load->total - load->loaded;
+   if (len > EA_EDITFIELD_LOAD_CHUNK)
+     {
+        len = EA_EDITFIELD_LOAD_CHUNK;
+        //Don't split a UTF-8 sequence between chunks.
+        while ((len > 1) &&
+               ((load->src[load->loaded + len] & 0xC0) == 0x80))
+          len--;
+     }
+
+   //"changed" callbacks and the progress callback may cancel the loading.
+   load->on_callback = EINA_TRUE;
+
+   if (len)
+     {
+        eina_strbuf_reset(load->buf);
+        _ea_text_markup_escape_append(load->buf, load->src + load->loaded, len);
+        elm_entry_entry_append(load->obj, eina_strbuf_string_get(load->buf));
+        load->loaded += len;
+     }
+
+   if (load->delete_me)
+     {
+        load->on_callback = EINA_FALSE;
+        load->idler = NULL;
+        _ea_editfield_load_del(load);
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   if (load->loaded == load->total)
+     {
+        eed = _ea_editfield_data_get(load->obj);
+        if (eed && (eed->load == load)) eed->load = NULL;
+        load->delete_me = EINA_TRUE;
+     }
+
+   if (load->func)
+     load->func(load->data, load->obj, load->loaded, load->total);
+
+   load->on_callback = EINA_FALSE;
+
+   if (load->delete_me)
+     {
+        load->idler = NULL;
+        _ea_editfield_load_del(load);
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_ea_editfield_load_start(Evas_Object *obj, Ea_Editfield_Load *load,
+                         Ea_Editfield_Load_Cb func, void *data)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed)
+     {
+        _ea_editfield_load_del(load);
+        return EINA_FALSE;
+     }
+
+   load->buf = eina_strbuf_new();
+   load->idler = ecore_idler_add(_ea_editfield_load_idler_cb, load);
+   if (!load->buf || !load->idler)
+     {
+        LOGE("Failed to start text loading");
+        _ea_editfield_load_del(load);
+        return EINA_FALSE;
+     }
+   load->obj = obj;
+   load->func = func;
+   load->data = data;
+
+   _ea_editfield_load_free(eed);
+   eed->load = load;
+   elm_entry_entry_set(obj, "");
+
+   return EINA_TRUE;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_editfield_load_free(Ea_Editfield_Data *eed)
+{
+   Ea_Editfield_Load *load = eed->load;
+
+   if (!load) return;
+   eed->load = NULL;
+
+   if (load->on_callback)
+     {
+        load->delete_me = EINA_TRUE;
+        return;
+     }
+   _ea_editfield_load_del(load);
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Eina_Bool
+ea_editfield_text_load(Evas_Object *obj, const char *path, Ea_Editfield_Load_Cb func, void *data)
+{
+   Ea_Editfield_Load *load;
+   struct stat st;
+   int fd;
+
+   if (!obj || !path) return EINA_FALSE;
+
+   fd = open(path, O_RDONLY);
+   if (fd < 0)
+     {
+        LOGE("Failed to open %s", path);
+        return EINA_FALSE;
+     }
+   if (fstat(fd, &st) < 0)
+     {
+        close(fd);
+        return EINA_FALSE;
+     }
+
+   load = calloc(1, sizeof(Ea_Editfield_Load));
+   if (!load)
+     {
+        LOGE("Failed to allocate text loading");
+        close(fd);
+        return EINA_FALSE;
+     }
+
+   if (st.st_size > 0)
+     {
+        load->map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (load->map == MAP_FAILED)
+          {
+             LOGE("Failed to map %s", path);
+             load->map = NULL;
+             close(fd);
+             _ea_editfield_load_del(load);
+             return EINA_FALSE;
+          }
+        madvise(load->map, st.st_size, MADV_SEQUENTIAL);
+        load->src = load->map;
+        load->total = st.st_size;
+     }
+   close(fd);
+
+   return _ea_editfield_load_start(obj, load, func, data);
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_text_buffer_load(Evas_Object *obj, const char *buf, size_t len, Ea_Editfield_Load_Cb func, void *data)
+{
+   Ea_Editfield_Load *load;
+
+   if (!obj || (!buf && len)) return EINA_FALSE;
+
+   load = calloc(1, sizeof(Ea_Editfield_Load));
+   if (!load)
+     {
+        LOGE("Failed to allocate text loading");
+        return EINA_FALSE;
+     }
+
+   if (len)
+     {
+        load->copy = malloc(len);
+        if (!load->copy)
+          {
+             LOGE("Failed to allocate text loading");
+             _ea_editfield_load_del(load);
+             return EINA_FALSE;
+          }
+        memcpy(load->copy, buf, len);
+        load->src = load->copy;
+        load->total = len;
+     }
+
+   return _ea_editfield_load_start(obj, load, func, data);
+}
+
+EXPORT_API void
+ea_editfield_text_load_cancel(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return;
+
+   _ea_editfield_load_free(eed);
+}
@@ -0,0 +1,133 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+typedef struct _Ea_Editfield_Preload
+{
+   Evas_Object *parent;
+   Ecore_Idler *idler;
+   unsigned int next;
+   Ea_Editfield_Preload_Cb func;
+   void *data;
+} Ea_Editfield_Preload;
+
+//Every type uses its own set of theme groups.
+static const Ea_Editfield_Type _preload_types[] =
+{
+   EA_EDITFIELD_SINGLELINE,
+   EA_EDITFIELD_SCROLL_SINGLELINE,
+   EA_EDITFIELD_SEARCHBAR,
+   EA_EDITFIELD_SCROLL_MULTILINE,
+   EA_EDITFIELD_SCROLL_SINGLELINE_PASSWORD,
+   EA_EDITFIELD_MULTILINE
+};
+
+static Eina_List *preloads = NULL;
+
+static void _ea_editfield_preload_parent_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
+
+static void
+_ea_editfield_preload_del(Ea_Editfield_Preload *preload)
+{
+   if (preload->idler) ecore_idler_del(preload->idler);
+   evas_object_event_callback_del_full(preload->parent, EVAS_CALLBACK_DEL,
+                                       _ea_editfield_preload_parent_del_cb,
+                                       preload);
+   preloads = eina_list_remove(preloads, preload);
+   _ea_mem_free(EA_MEMORY_EDITFIELD, preload, sizeof(Ea_Editfield_Preload));
+}
+
+static void
+_ea_editfield_preload_done(Ea_Editfield_Preload *preload)
+{
+   //The callback may delete the parent.
+   evas_object_event_callback_del_full(preload->parent, EVAS_CALLBACK_DEL,
+                                       _ea_editfield_preload_parent_del_cb,
+                                       preload);
+   preloads = eina_list_remove(preloads, preload);
+   if (preload->func) preload->func(preload->data, preload->parent);
+   _ea_mem_free(EA_MEMORY_EDITFIELD, preload, sizeof(Ea_Editfield_Preload));
+}
+
+static void
+_ea_editfield_preload_parent_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   _ea_editfield_preload_del(data);
+}
+
+static Eina_Bool
+_ea_editfield_preload_idler_cb(void *data)
+{
+   Ea_Editfield_Preload *preload = data;
+   Evas_Object *entry;
+
+   //Calculate a hidden editfield to load the groups, the text classes and
+   //the fonts. The edje caches keep them after the editfield is deleted.
+   entry = ea_editfield_add(preload->parent,
+                            _preload_types[preload->next]);
+   elm_entry_entry_set(entry, "Aa");
+   evas_object_resize(entry, 480, 80);
+   evas_object_smart_calculate(entry);
+   evas_object_del(entry);
+
+   preload->next++;
+   if (preload->next < (sizeof(_preload_types) / sizeof(_preload_types[0])))
+     return ECORE_CALLBACK_RENEW;
+
+   preload->idler = NULL;
+   _ea_editfield_preload_done(preload);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+//Stop preloading under memory pressure. The application still gets its
+//callback, so it doesn't wait for the preload forever.
+void
+_ea_editfield_preload_trim(void)
+{
+   Ea_Editfield_Preload *preload;
+
+   while (preloads)
+     {
+        preload = eina_list_data_get(preloads);
+        ecore_idler_del(preload->idler);
+        preload->idler = NULL;
+        _ea_editfield_preload_done(preload);
+     }
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API void
+ea_editfield_styles_preload(Evas_Object *parent, Ea_Editfield_Preload_Cb func, void *data)
+{
+   Ea_Editfield_Preload *preload;
+
+   if (!parent) return;
+
+   preload = _ea_mem_calloc(EA_MEMORY_EDITFIELD, sizeof(Ea_Editfield_Preload));
+   if (!preload)
+     {
+        LOGE("Failed to allocate editfield preload");
+        return;
+     }
+   preload->parent = parent;
+   preload->func = func;
+   preload->data = data;
+
+   preload->idler = ecore_idler_add(_ea_editfield_preload_idler_cb, preload);
+   if (!preload->idler)
+     {
+        LOGE("Failed to start editfield preload");
+        _ea_mem_free(EA_MEMORY_EDITFIELD, preload, sizeof(Ea_Editfield_Preload));
+        return;
+     }
+   preloads = eina_list_append(preloads, preload);
+   evas_object_event_callback_add(parent, EVAS_CALLBACK_DEL,
+                                  _ea_editfield_preload_parent_del_cb, preload);
+}
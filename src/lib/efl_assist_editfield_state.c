@@ -0,0 +1,232 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+#include <stdint.h>
+
+#define EA_EDITFIELD_STATE_MAGIC   0x53454145   //"EAES"
+#define EA_EDITFIELD_STATE_VERSION 1
+
+#define EA_EDITFIELD_STATE_CLEAR_BTN_DISABLED 0x01
+
+/* The blob is the header followed by one record per editfield in the order
+ * of the object tree. Each record is followed by its markup text without NUL.
+ * The blob is meant for the same process image, so the native byte order is
+ * used. */
+typedef struct _Ea_Editfield_State_Header
+{
+   uint32_t magic;
+   uint16_t version;
+   uint16_t count;
+} Ea_Editfield_State_Header;
+
+typedef struct _Ea_Editfield_State_Record
+{
+   uint32_t size;     //bytes of the text
+   int32_t cursor;
+   int32_t anchor;    //other end of the selection, same as cursor if none
+   uint8_t type;
+   uint8_t flags;
+   uint16_t reserved;
+} Ea_Editfield_State_Record;
+
+static void
+_ea_editfield_state_collect(Evas_Object *obj, Eina_List **list)
+{
+   Eina_List *members, *l;
+   Evas_Object *member;
+
+   if (_ea_editfield_data_get(obj))
+     {
+        *list = eina_list_append(*list, obj);
+        return;
+     }
+
+   members = evas_object_smart_members_get(obj);
+   EINA_LIST_FOREACH(members, l, member)
+     _ea_editfield_state_collect(member, list);
+   eina_list_free(members);
+}
+
+static int
+_ea_editfield_state_anchor_get(Evas_Object *obj, int cursor)
+{
+   Evas_Object *edje;
+   int begin, end;
+
+   if (!elm_entry_selection_get(obj)) return cursor;
+
+   edje = elm_layout_edje_get(obj);
+   begin = edje_object_part_text_cursor_pos_get(edje, "elm.text",
+                                                EDJE_CURSOR_SELECTION_BEGIN);
+   end = edje_object_part_text_cursor_pos_get(edje, "elm.text",
+                                              EDJE_CURSOR_SELECTION_END);
+
+   return (cursor == begin) ? end : begin;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Eina_Binbuf *
+ea_editfield_state_save(Evas_Object *parent)
+{
+   Ea_Editfield_State_Header header;
+   Ea_Editfield_State_Record record;
+   Ea_Editfield_Data *eed;
+   Eina_Binbuf *buf;
+   Eina_List *list = NULL;
+   Evas_Object *obj;
+   const char *text;
+
+   if (!parent) return NULL;
+
+   _ea_editfield_state_collect(parent, &list);
+   if (eina_list_count(list) > UINT16_MAX)
+     {
+        LOGW("Too many editfields(%u)", eina_list_count(list));
+        eina_list_free(list);
+        return NULL;
+     }
+
+   buf = eina_binbuf_new();
+   if (!buf)
+     {
+        LOGE("Failed to allocate editfield state");
+        eina_list_free(list);
+        return NULL;
+     }
+
+   header.magic = EA_EDITFIELD_STATE_MAGIC;
+   header.version = EA_EDITFIELD_STATE_VERSION;
+   header.count = eina_list_count(list);
+   eina_binbuf_append_length(buf, (const unsigned char *) &header, sizeof(header));
+
+   EINA_LIST_FREE(list, obj)
+     {
+        eed = _ea_editfield_data_get(obj);
+        memset(&record, 0, sizeof(record));
+
+        //The blob is stored by the application. A password is not written,
+        //nor its cursor which gives away its length.
+        if (eed->type == EA_EDITFIELD_SCROLL_SINGLELINE_PASSWORD)
+          text = "";
+        else
+          {
+             text = elm_entry_entry_get(obj);
+             if (!text) text = "";
+             record.cursor = elm_entry_cursor_pos_get(obj);
+             record.anchor = _ea_editfield_state_anchor_get(obj, record.cursor);
+          }
+        record.size = strlen(text);
+        record.type = eed->type;
+        if (eed->clear_btn_disabled)
+          record.flags |= EA_EDITFIELD_STATE_CLEAR_BTN_DISABLED;
+
+        eina_binbuf_append_length(buf, (const unsigned char *) &record, sizeof(record));
+        eina_binbuf_append_length(buf, (const unsigned char *) text, record.size);
+     }
+
+   return buf;
+}
+
+static const unsigned char *
+_ea_editfield_state_record_get(const unsigned char *p, const unsigned char *end,
+                               Ea_Editfield_State_Record *record)
+{
+   if ((size_t)(end - p) < sizeof(Ea_Editfield_State_Record)) return NULL;
+   memcpy(record, p, sizeof(Ea_Editfield_State_Record));
+   p += sizeof(Ea_Editfield_State_Record);
+   if ((size_t)(end - p) < record->size) return NULL;
+
+   return p;
+}
+
+EXPORT_API Eina_Bool
+ea_editfield_state_restore(Evas_Object *parent, const void *blob, size_t size)
+{
+   Ea_Editfield_State_Header header;
+   Ea_Editfield_State_Record record;
+   Ea_Editfield_Data *eed;
+   Eina_List *list = NULL, *l;
+   Eina_Strbuf *buf;
+   Evas_Object *obj;
+   Evas *e;
+   const unsigned char *p, *end;
+
+   if (!parent || !blob || (size < sizeof(header))) return EINA_FALSE;
+
+   memcpy(&header, blob, sizeof(header));
+   if ((header.magic != EA_EDITFIELD_STATE_MAGIC) ||
+       (header.version != EA_EDITFIELD_STATE_VERSION))
+     {
+        LOGW("Invalid editfield state");
+        return EINA_FALSE;
+     }
+   end = (const unsigned char *) blob + size;
+
+   _ea_editfield_state_collect(parent, &list);
+   if (eina_list_count(list) != header.count)
+     {
+        LOGW("Editfield count mismatch(%u, %u)", eina_list_count(list), header.count);
+        eina_list_free(list);
+        return EINA_FALSE;
+     }
+
+   //Check the whole blob first not to leave the editfields half restored.
+   p = (const unsigned char *) blob + sizeof(header);
+   EINA_LIST_FOREACH(list, l, obj)
+     {
+        p = _ea_editfield_state_record_get(p, end, &record);
+        eed = _ea_editfield_data_get(obj);
+        if (!p || (eed->type != record.type))
+          {
+             LOGW("Editfield state doesn't match the editfields");
+             eina_list_free(list);
+             return EINA_FALSE;
+          }
+        p += record.size;
+     }
+
+   buf = eina_strbuf_new();
+   if (!buf)
+     {
+        LOGE("Failed to allocate editfield state");
+        eina_list_free(list);
+        return EINA_FALSE;
+     }
+
+   //Set all editfields in one pass without recalculation between them.
+   e = evas_object_evas_get(parent);
+   evas_event_freeze(e);
+   edje_freeze();
+
+   p = (const unsigned char *) blob + sizeof(header);
+   EINA_LIST_FREE(list, obj)
+     {
+        p = _ea_editfield_state_record_get(p, end, &record);
+
+        eina_strbuf_reset(buf);
+        eina_strbuf_append_length(buf, (const char *) p, record.size);
+        p += record.size;
+        elm_entry_entry_set(obj, eina_strbuf_string_get(buf));
+
+        if (record.anchor != record.cursor)
+          {
+             elm_entry_cursor_pos_set(obj, record.anchor);
+             elm_entry_cursor_selection_begin(obj);
+             elm_entry_cursor_pos_set(obj, record.cursor);
+             elm_entry_cursor_selection_end(obj);
+          }
+        else
+          elm_entry_cursor_pos_set(obj, record.cursor);
+
+        ea_editfield_clear_button_disabled_set(obj,
+           !!(record.flags & EA_EDITFIELD_STATE_CLEAR_BTN_DISABLED));
+     }
+
+   edje_thaw();
+   evas_event_thaw(e);
+   eina_strbuf_free(buf);
+
+   return EINA_TRUE;
+}
@@ -1,33 +1,32 @@
 #include "efl_assist.h"
 #include "efl_assist_private.h"
 
-typedef struct _Ea_Event_Mgr Ea_Event_Mgr;
-
 struct _Ea_Event_Mgr
 {
+   EA_MAGIC;
    Eina_List *obj_events;
    Evas *e;
    Evas_Object *key_grab_rect;
 };
 
-typedef struct _Ea_Object_Event
+struct _Ea_Object_Event
 {
+   EA_MAGIC;
    Evas_Object *obj;
    Evas_Object *parent;
    Eina_List *callbacks;
    Eina_Bool delete_me : 1;
    Eina_Bool on_callback : 1;
-} Ea_Object_Event;
+};
 
 typedef struct _Ea_Event_Callback
 {
+   EA_MAGIC;
    Ea_Callback_Type type;
    void (*func)(void *data, Evas_Object *obj, void *event_info);
    void *data;
 } Ea_Event_Callback;
 
-const char *EA_OBJ_KEY_EVENT_MGR = "_ea_obj_key_event_mgr";
-const char *EA_OBJ_KEY_OBJ_EVENT = "_ea_obj_key_obj_event";
 const char *EA_KEY_STOP = "XF86Stop";
 const char *EA_KEY_STOP2 = "Escape";
 const char *EA_KEY_SEND = "XF86Send";
@@ -36,6 +35,20 @@ const char *EA_KEY_SEND2 = "Menu";
 
 static Eina_List *event_mgrs = NULL;
 
+static void
+_ea_event_callback_free(Ea_Event_Callback *callback)
+{
+   EA_MAGIC_SET(callback, EA_MAGIC_NONE);
+   _ea_mem_free(EA_MEMORY_CALLBACK, callback, sizeof(Ea_Event_Callback));
+}
+
+static void
+_ea_object_event_free(Ea_Object_Event *obj_event)
+{
+   EA_MAGIC_SET(obj_event, EA_MAGIC_NONE);
+   _ea_mem_free(EA_MEMORY_OBJECT_EVENT, obj_event, sizeof(Ea_Object_Event));
+}
+
 static void
 _ea_event_mgr_del(Ea_Event_Mgr *event_mgr)
 {
@@ -44,28 +57,32 @@ _ea_event_mgr_del(Ea_Event_Mgr *event_mgr)
    //Redundant Event Mgr. Remove it.
    evas_object_del(event_mgr->key_grab_rect);
    event_mgrs = eina_list_remove(event_mgrs, event_mgr);
-   free(event_mgr);
+   EA_MAGIC_SET(event_mgr, EA_MAGIC_NONE);
+   _ea_mem_free(EA_MEMORY_EVENT_MGR, event_mgr, sizeof(Ea_Event_Mgr));
 }
 
-static void
-_ea_object_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+void
+_ea_event_object_del(Ea_Object_Data *od)
 {
-   Ea_Event_Mgr *event_mgr = evas_object_data_get(obj, EA_OBJ_KEY_EVENT_MGR);
-   Ea_Object_Event *obj_event = data;
+   Ea_Event_Mgr *event_mgr = od->event_mgr;
+   Ea_Object_Event *obj_event = od->obj_event;
    Eina_List *l;
    Ea_Event_Callback *callback;
 
+   od->event_mgr = NULL;
+   od->obj_event = NULL;
+
    l = eina_list_data_find_list(event_mgr->obj_events, obj_event);
    if (!l) return;
 
    event_mgr->obj_events = eina_list_remove_list(event_mgr->obj_events, l);
 
    EINA_LIST_FOREACH(obj_event->callbacks, l, callback)
-      free(callback);
+     _ea_event_callback_free(callback);
    obj_event->callbacks = eina_list_free(obj_event->callbacks);
 
    if (obj_event->on_callback) obj_event->delete_me = EINA_TRUE;
-   else free(obj_event);
+   else _ea_object_event_free(obj_event);
 
    _ea_event_mgr_del(event_mgr);
 }
@@ -233,10 +250,23 @@ _ea_key_grab_rect_key_up_cb(void *data, Evas *e, Evas_Object *obj,
    Ea_Object_Event *obj_event;
    Ea_Event_Callback *callback;
    Ea_Callback_Type type;
-   Eina_List *l;
+   Eina_List *callbacks, *l;
+   unsigned int generation;
+
+   if (!EA_MAGIC_CHECK(event_mgr, EA_MAGIC_EVENT_MGR))
+     {
+        EA_MAGIC_FAIL(event_mgr, EA_MAGIC_EVENT_MGR, __func__);
+        return;
+     }
 
    obj_event = _ea_top_obj_event_find(event_mgr);
    if (!obj_event) return;
+   if (!EA_MAGIC_CHECK(obj_event, EA_MAGIC_OBJECT_EVENT))
+     {
+        EA_MAGIC_FAIL(obj_event, EA_MAGIC_OBJECT_EVENT, __func__);
+        return;
+     }
+   generation = EA_MAGIC_GENERATION(obj_event);
 
    if (!strcmp(ev->keyname, EA_KEY_STOP) || !strcmp(ev->keyname, EA_KEY_STOP2))
      type = EA_CALLBACK_BACK;
@@ -245,14 +275,35 @@ _ea_key_grab_rect_key_up_cb(void *data, Evas *e, Evas_Object *obj,
      type = EA_CALLBACK_MORE;
    else return;
 
+   //Walk a copy. A callback may remove callbacks of this object or delete
+   //the object, which frees the nodes of obj_event->callbacks.
+   callbacks = eina_list_clone(obj_event->callbacks);
+
    obj_event->on_callback = EINA_TRUE;
-   EINA_LIST_FOREACH(obj_event->callbacks, l, callback)
+   EINA_LIST_FOREACH(callbacks, l, callback)
      {
         if (obj_event->delete_me) break;
+        //Removed by an earlier callback.
+        if (!eina_list_data_find(obj_event->callbacks, callback)) continue;
+        if (!EA_MAGIC_CHECK(callback, EA_MAGIC_EVENT_CALLBACK))
+          {
+             EA_MAGIC_FAIL(callback, EA_MAGIC_EVENT_CALLBACK, __func__);
+             break;
+          }
         if (callback->type != type) continue;
         callback->func(callback->data, obj_event->obj, (void*) type);
+
+        //The object event must outlive the callbacks (see delete_me).
+        if (!EA_MAGIC_GEN_CHECK(obj_event, EA_MAGIC_OBJECT_EVENT, generation))
+          {
+             EA_MAGIC_FAIL(obj_event, EA_MAGIC_OBJECT_EVENT, __func__);
+             eina_list_free(callbacks);
+             return;
+          }
      }
-   if (obj_event->delete_me) free(obj_event);
+   eina_list_free(callbacks);
+
+   if (obj_event->delete_me) _ea_object_event_free(obj_event);
    else obj_event->on_callback = EINA_FALSE;
 }
 
@@ -281,12 +332,13 @@ _ea_key_grab_obj_create(Ea_Event_Mgr *event_mgr)
 static Ea_Event_Mgr *
 _ea_event_mgr_new(Evas *e)
 {
-   Ea_Event_Mgr *event_mgr = calloc(1, sizeof(Ea_Event_Mgr));
+   Ea_Event_Mgr *event_mgr = _ea_mem_calloc(EA_MEMORY_EVENT_MGR, sizeof(Ea_Event_Mgr));
    if (!event_mgr)
      {
         LOGE("Failed to allocate event manager");
         return NULL;
      }
+   EA_MAGIC_SET(event_mgr, EA_MAGIC_EVENT_MGR);
    event_mgr->e = e;
    _ea_key_grab_obj_create(event_mgr);
 
@@ -296,6 +348,7 @@ _ea_event_mgr_new(Evas *e)
 EAPI void *
 ea_object_event_callback_del(Evas_Object *obj, Ea_Callback_Type type, Ea_Event_Cb func)
 {
+   Ea_Object_Data *od;
    Ea_Object_Event *obj_event;
    Ea_Event_Mgr *event_mgr;
    Eina_List *l;
@@ -303,39 +356,53 @@ ea_object_event_callback_del(Evas_Object *obj, Ea_Callback_Type type, Ea_Event_C
    void *data;
 
    //Check the validation
-   event_mgr = evas_object_data_get(obj, EA_OBJ_KEY_EVENT_MGR);
-   obj_event = evas_object_data_get(obj, EA_OBJ_KEY_OBJ_EVENT);
-
-   if (!event_mgr || !obj_event)
+   od = _ea_object_data_get(obj);
+   if (!od || !od->event_mgr || !od->obj_event)
      {
         LOGW("This object(%p) hasn't been registered before", obj);
         return NULL;
      }
-
-   evas_object_event_callback_del(obj, EVAS_CALLBACK_DEL, _ea_object_del_cb);
+   event_mgr = od->event_mgr;
+   obj_event = od->obj_event;
+   if (!EA_MAGIC_CHECK(event_mgr, EA_MAGIC_EVENT_MGR))
+     {
+        EA_MAGIC_FAIL(event_mgr, EA_MAGIC_EVENT_MGR, __func__);
+        return NULL;
+     }
+   if (!EA_MAGIC_CHECK(obj_event, EA_MAGIC_OBJECT_EVENT))
+     {
+        EA_MAGIC_FAIL(obj_event, EA_MAGIC_OBJECT_EVENT, __func__);
+        return NULL;
+     }
 
    //Remove the callback data
    EINA_LIST_REVERSE_FOREACH(obj_event->callbacks, l, callback)
      {
         if ((callback->func == func) && (callback->type == type)) break;
      }
+   if (!l)
+     {
+        LOGW("This callback(%p) hasn't been registered before", func);
+        return NULL;
+     }
 
    data = callback->data;
    obj_event->callbacks = eina_list_remove_list(obj_event->callbacks, l);
-   free(callback);
+   _ea_event_callback_free(callback);
 
    //This object is not managed anymore.
    if (!obj_event->callbacks)
      {
-        evas_object_data_set(obj, EA_OBJ_KEY_OBJ_EVENT, NULL);
-        evas_object_data_set(obj, EA_OBJ_KEY_EVENT_MGR, NULL);
+        od->obj_event = NULL;
+        od->event_mgr = NULL;
+        _ea_object_data_release(od);
         Eina_List *l = eina_list_data_find_list(event_mgr->obj_events,
                                                 obj_event);
         if (l)
           event_mgr->obj_events = eina_list_remove_list(event_mgr->obj_events,
                                                         l);
         if (obj_event->on_callback) obj_event->delete_me = EINA_TRUE;
-        else free(obj_event);
+        else _ea_object_event_free(obj_event);
      }
 
    _ea_event_mgr_del(event_mgr);
@@ -348,6 +415,7 @@ ea_object_event_callback_add(Evas_Object *obj, Ea_Callback_Type type, Ea_Event_C
 {
    Ea_Event_Mgr *event_mgr;
    Evas *e;
+   Ea_Object_Data *od;
    Ea_Object_Event *obj_event = NULL;
    Eina_List *l;
    Ea_Event_Callback *callback;
@@ -372,34 +440,59 @@ ea_object_event_callback_add(Evas_Object *obj, Ea_Callback_Type type, Ea_Event_C
         event_mgrs = eina_list_append(event_mgrs, event_mgr);
      }
 
-   obj_event = evas_object_data_get(obj, EA_OBJ_KEY_OBJ_EVENT);
+   //A new manager is deleted again on the failures below.
+   od = _ea_object_data_add(obj);
+   if (!od)
+     {
+        _ea_event_mgr_del(event_mgr);
+        return;
+     }
+   obj_event = od->obj_event;
+   if (obj_event && !EA_MAGIC_CHECK(obj_event, EA_MAGIC_OBJECT_EVENT))
+     {
+        EA_MAGIC_FAIL(obj_event, EA_MAGIC_OBJECT_EVENT, __func__);
+        _ea_object_data_release(od);
+        _ea_event_mgr_del(event_mgr);
+        return;
+     }
 
    //New Object Event. Probably user adds ea_object_event_callback first time.
    if (!obj_event)
      {
-        obj_event = calloc(1, sizeof(Ea_Object_Event));
+        obj_event = _ea_mem_calloc(EA_MEMORY_OBJECT_EVENT, sizeof(Ea_Object_Event));
         if (!obj_event)
           {
              LOGE("Failed to allocate object event");
+             _ea_object_data_release(od);
+             _ea_event_mgr_del(event_mgr);
              return;
           }
-        evas_object_data_set(obj, EA_OBJ_KEY_OBJ_EVENT, obj_event);
-        evas_object_data_set(obj, EA_OBJ_KEY_EVENT_MGR, event_mgr);
-        evas_object_event_callback_add(obj, EVAS_CALLBACK_DEL,
-                                       _ea_object_del_cb,
-                                       obj_event);
+        EA_MAGIC_SET(obj_event, EA_MAGIC_OBJECT_EVENT);
+        od->obj_event = obj_event;
+        od->event_mgr = event_mgr;
         event_mgr->obj_events = eina_list_append(event_mgr->obj_events,
                                                  obj_event);
         obj_event->obj = obj;
      }
 
    //Append this callback.
-   callback = calloc(1, sizeof(Ea_Event_Callback));
+   callback = _ea_mem_calloc(EA_MEMORY_CALLBACK, sizeof(Ea_Event_Callback));
    if (!callback)
      {
         LOGE("Failed to allocate event callback");
+        if (obj_event->callbacks) return;
+
+        //The object event was made for this callback.
+        od->obj_event = NULL;
+        od->event_mgr = NULL;
+        _ea_object_data_release(od);
+        event_mgr->obj_events = eina_list_remove(event_mgr->obj_events,
+                                                 obj_event);
+        _ea_object_event_free(obj_event);
+        _ea_event_mgr_del(event_mgr);
         return;
      }
+   EA_MAGIC_SET(callback, EA_MAGIC_EVENT_CALLBACK);
    callback->type = type;
    callback->func = func;
    callback->data = data;
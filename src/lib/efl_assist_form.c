@@ -0,0 +1,285 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+typedef struct _Ea_Form_Binding Ea_Form_Binding;
+
+typedef struct _Ea_Form_Field
+{
+   const char *text;            //stringshared markup
+   Ea_Form_Binding *binding;    //only while the field has an editfield
+   unsigned char type;
+   Eina_Bool valid : 1;
+   Eina_Bool validated : 1;
+} Ea_Form_Field;
+
+struct _Ea_Form_Binding
+{
+   Ea_Form *form;
+   Evas_Object *obj;
+   unsigned int index;
+};
+
+struct _Ea_Form
+{
+   Ea_Form_Field *fields;
+   unsigned int count;
+   unsigned int alloc;
+   Ea_Form_Validate_Cb validate_func;
+   void *validate_data;
+};
+
+static void _ea_form_editfield_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
+static void _ea_form_editfield_changed_cb(void *data, Evas_Object *obj, void *event_info);
+
+static void
+_ea_form_field_sync(Ea_Form_Field *field)
+{
+   if (!field->binding) return;
+   eina_stringshare_replace(&field->text,
+                            elm_entry_entry_get(field->binding->obj));
+}
+
+static void
+_ea_form_field_unbind(Ea_Form_Field *field)
+{
+   Ea_Form_Binding *binding = field->binding;
+
+   if (!binding) return;
+
+   evas_object_event_callback_del_full(binding->obj, EVAS_CALLBACK_DEL,
+                                       _ea_form_editfield_del_cb, binding);
+   evas_object_smart_callback_del_full(binding->obj, "changed",
+                                       _ea_form_editfield_changed_cb, binding);
+   field->binding = NULL;
+   free(binding);
+}
+
+static void
+_ea_form_editfield_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   Ea_Form_Binding *binding = data;
+   Ea_Form_Field *field = binding->form->fields + binding->index;
+
+   _ea_form_field_sync(field);
+   _ea_form_field_unbind(field);
+}
+
+static void
+_ea_form_editfield_changed_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Form_Binding *binding = data;
+
+   binding->form->fields[binding->index].validated = EINA_FALSE;
+}
+
+static Eina_Bool
+_ea_form_field_index_check(const Ea_Form *form, unsigned int index)
+{
+   if (!form) return EINA_FALSE;
+   if (index >= form->count)
+     {
+        LOGW("Invalid form field index(%u)", index);
+        return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Ea_Form *
+ea_form_add(void)
+{
+   Ea_Form *form = calloc(1, sizeof(Ea_Form));
+
+   if (!form) LOGE("Failed to allocate form");
+
+   return form;
+}
+
+EXPORT_API void
+ea_form_del(Ea_Form *form)
+{
+   unsigned int i;
+
+   if (!form) return;
+
+   for (i = 0; i < form->count; i++)
+     {
+        _ea_form_field_unbind(form->fields + i);
+        eina_stringshare_del(form->fields[i].text);
+     }
+   free(form->fields);
+   free(form);
+}
+
+EXPORT_API int
+ea_form_field_append(Ea_Form *form, Ea_Editfield_Type type, const char *text)
+{
+   Ea_Form_Field *fields, *field;
+   unsigned int alloc;
+
+   if (!form) return -1;
+
+   if (form->count == form->alloc)
+     {
+        alloc = form->alloc ? form->alloc * 2 : 16;
+        fields = realloc(form->fields, sizeof(Ea_Form_Field) * alloc);
+        if (!fields)
+          {
+             LOGE("Failed to allocate form field");
+             return -1;
+          }
+        form->fields = fields;
+        form->alloc = alloc;
+     }
+
+   field = form->fields + form->count;
+   memset(field, 0, sizeof(Ea_Form_Field));
+   field->type = type;
+   field->text = eina_stringshare_add(text ? text : "");
+
+   return form->count++;
+}
+
+EXPORT_API unsigned int
+ea_form_field_count_get(const Ea_Form *form)
+{
+   if (!form) return 0;
+   return form->count;
+}
+
+EXPORT_API Ea_Editfield_Type
+ea_form_field_type_get(const Ea_Form *form, unsigned int index)
+{
+   if (!_ea_form_field_index_check(form, index)) return EA_EDITFIELD_SINGLELINE;
+   return form->fields[index].type;
+}
+
+EXPORT_API void
+ea_form_field_text_set(Ea_Form *form, unsigned int index, const char *text)
+{
+   Ea_Form_Field *field;
+
+   if (!_ea_form_field_index_check(form, index)) return;
+
+   field = form->fields + index;
+   eina_stringshare_replace(&field->text, text ? text : "");
+   field->validated = EINA_FALSE;
+   if (field->binding)
+     elm_entry_entry_set(field->binding->obj, field->text);
+}
+
+EXPORT_API const char *
+ea_form_field_text_get(Ea_Form *form, unsigned int index)
+{
+   Ea_Form_Field *field;
+
+   if (!_ea_form_field_index_check(form, index)) return NULL;
+
+   field = form->fields + index;
+   _ea_form_field_sync(field);
+
+   return field->text;
+}
+
+EXPORT_API void
+ea_form_validate_cb_set(Ea_Form *form, Ea_Form_Validate_Cb func, void *data)
+{
+   unsigned int i;
+
+   if (!form) return;
+
+   form->validate_func = func;
+   form->validate_data = data;
+   for (i = 0; i < form->count; i++)
+     form->fields[i].validated = EINA_FALSE;
+}
+
+EXPORT_API Eina_Bool
+ea_form_field_valid_get(Ea_Form *form, unsigned int index)
+{
+   Ea_Form_Field *field;
+   char *text;
+
+   if (!_ea_form_field_index_check(form, index)) return EINA_FALSE;
+
+   field = form->fields + index;
+   if (field->validated) return field->valid;
+
+   if (!form->validate_func)
+     field->valid = EINA_TRUE;
+   else if (field->binding)
+     field->valid = !!form->validate_func(form->validate_data, form, index,
+                                          ea_editfield_text_utf8_get(field->binding->obj));
+   else
+     {
+        text = elm_entry_markup_to_utf8(field->text);
+        field->valid = !!form->validate_func(form->validate_data, form, index,
+                                             text ? text : "");
+        free(text);
+     }
+   field->validated = EINA_TRUE;
+
+   return field->valid;
+}
+
+EXPORT_API int
+ea_form_validate(Ea_Form *form)
+{
+   unsigned int i;
+
+   if (!form) return -1;
+
+   for (i = 0; i < form->count; i++)
+     {
+        if (!ea_form_field_valid_get(form, i)) return i;
+     }
+   return -1;
+}
+
+EXPORT_API Evas_Object *
+ea_form_field_editfield_add(Ea_Form *form, unsigned int index, Evas_Object *parent)
+{
+   Ea_Form_Binding *binding;
+   Ea_Form_Field *field;
+   Evas_Object *obj;
+
+   if (!_ea_form_field_index_check(form, index)) return NULL;
+
+   field = form->fields + index;
+   _ea_form_field_sync(field);
+   _ea_form_field_unbind(field);
+
+   binding = calloc(1, sizeof(Ea_Form_Binding));
+   if (!binding)
+     {
+        LOGE("Failed to allocate form binding");
+        return NULL;
+     }
+
+   obj = ea_editfield_add(parent, field->type);
+   elm_entry_entry_set(obj, field->text);
+
+   binding->form = form;
+   binding->obj = obj;
+   binding->index = index;
+   field->binding = binding;
+
+   evas_object_event_callback_add(obj, EVAS_CALLBACK_DEL,
+                                  _ea_form_editfield_del_cb, binding);
+   evas_object_smart_callback_add(obj, "changed",
+                                  _ea_form_editfield_changed_cb, binding);
+
+   return obj;
+}
+
+EXPORT_API Evas_Object *
+ea_form_field_editfield_get(const Ea_Form *form, unsigned int index)
+{
+   if (!_ea_form_field_index_check(form, index)) return NULL;
+   if (!form->fields[index].binding) return NULL;
+
+   return form->fields[index].binding->obj;
+}
@@ -0,0 +1,370 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+#define EA_NAVIFRAME_PREBUILD_BUDGET 2   //pages
+
+typedef struct _Ea_Naviframe_Page
+{
+   Ea_Naviframe_Data *nd;
+   const char *name;   //stringshared
+   Ea_Naviframe_Page_Build_Cb func;
+   void *data;
+   Evas_Object *content;   //prebuilt, hidden and not pushed yet
+   Eina_Bool failed : 1;   //not tried again until registered or invalidated
+} Ea_Naviframe_Page;
+
+struct _Ea_Naviframe_Data
+{
+   Evas_Object *naviframe;
+   Eina_List *pages;
+   Ecore_Idler *idler;
+   unsigned int budget;
+   unsigned int built;
+};
+
+static Eina_List *naviframes = NULL;
+
+static void _ea_naviframe_page_content_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
+
+static Ea_Naviframe_Data *
+_ea_naviframe_data_get(const Evas_Object *naviframe)
+{
+   Ea_Object_Data *od = _ea_object_data_get(naviframe);
+
+   return od ? od->naviframe : NULL;
+}
+
+static Ea_Naviframe_Page *
+_ea_naviframe_page_find(Ea_Naviframe_Data *nd, const char *name)
+{
+   Ea_Naviframe_Page *page;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(nd->pages, l, page)
+     {
+        if (!strcmp(page->name, name)) return page;
+     }
+
+   return NULL;
+}
+
+//Take the prebuilt content from the page. The caller owns it.
+static Evas_Object *
+_ea_naviframe_page_content_take(Ea_Naviframe_Page *page)
+{
+   Evas_Object *content = page->content;
+
+   if (!content) return NULL;
+
+   evas_object_event_callback_del_full(content, EVAS_CALLBACK_DEL,
+                                       _ea_naviframe_page_content_del_cb, page);
+   page->content = NULL;
+   page->nd->built--;
+
+   return content;
+}
+
+static void
+_ea_naviframe_page_discard(Ea_Naviframe_Page *page)
+{
+   Evas_Object *content = _ea_naviframe_page_content_take(page);
+
+   if (content) evas_object_del(content);
+}
+
+static void
+_ea_naviframe_page_content_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   Ea_Naviframe_Page *page = data;
+
+   //Deleted by someone else, e.g. with the naviframe.
+   page->content = NULL;
+   page->nd->built--;
+}
+
+static void
+_ea_naviframe_page_free(Ea_Naviframe_Page *page)
+{
+   _ea_naviframe_page_discard(page);
+   eina_stringshare_del(page->name);
+   _ea_mem_free(EA_MEMORY_PAGE, page, sizeof(Ea_Naviframe_Page));
+}
+
+static Ea_Naviframe_Page *
+_ea_naviframe_page_next_get(Ea_Naviframe_Data *nd)
+{
+   Ea_Naviframe_Page *page;
+   Eina_List *l;
+
+   if (nd->built >= nd->budget) return NULL;
+
+   //The earlier registered pages are the more likely ones.
+   EINA_LIST_FOREACH(nd->pages, l, page)
+     {
+        if (!page->content && !page->failed) return page;
+     }
+
+   return NULL;
+}
+
+static Eina_Bool
+_ea_naviframe_idler_cb(void *data)
+{
+   Ea_Naviframe_Data *nd = data;
+   Ea_Naviframe_Page *page;
+   Ea_Naviframe_Page_Build_Cb func;
+   Evas_Object *content;
+
+   page = _ea_naviframe_page_next_get(nd);
+   if (!page)
+     {
+        nd->idler = NULL;
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   //One page per idle round, so the main loop stays responsive.
+   func = page->func;
+   content = func(page->data, nd->naviframe);
+
+   //The builder may have deleted the naviframe, or deleted or replaced
+   //its own page. Then the content is not wanted anymore.
+   if (!eina_list_data_find(naviframes, nd))
+     {
+        if (content) evas_object_del(content);
+        return ECORE_CALLBACK_CANCEL;
+     }
+   if (!eina_list_data_find(nd->pages, page) || (page->func != func) ||
+       page->content)
+     {
+        if (content) evas_object_del(content);
+     }
+   else if (!content)
+     {
+        LOGW("Failed to prebuild the page(%s)", page->name);
+        page->failed = EINA_TRUE;
+     }
+   else
+     {
+        evas_object_hide(content);
+        evas_object_event_callback_add(content, EVAS_CALLBACK_DEL,
+                                       _ea_naviframe_page_content_del_cb, page);
+        page->content = content;
+        nd->built++;
+     }
+
+   if (_ea_naviframe_page_next_get(nd)) return ECORE_CALLBACK_RENEW;
+
+   nd->idler = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_ea_naviframe_prebuild_schedule(Ea_Naviframe_Data *nd)
+{
+   if (nd->idler || !_ea_naviframe_page_next_get(nd)) return;
+
+   nd->idler = ecore_idler_add(_ea_naviframe_idler_cb, nd);
+   if (!nd->idler)
+     LOGE("Failed to start page prebuild");
+}
+
+static Ea_Naviframe_Data *
+_ea_naviframe_data_add(Evas_Object *naviframe)
+{
+   Ea_Object_Data *od;
+   Ea_Naviframe_Data *nd;
+
+   od = _ea_object_data_add(naviframe);
+   if (!od) return NULL;
+   if (od->naviframe) return od->naviframe;
+
+   nd = _ea_mem_calloc(EA_MEMORY_PAGE, sizeof(Ea_Naviframe_Data));
+   if (!nd)
+     {
+        LOGE("Failed to allocate naviframe data");
+        _ea_object_data_release(od);
+        return NULL;
+     }
+   nd->naviframe = naviframe;
+   nd->budget = EA_NAVIFRAME_PREBUILD_BUDGET;
+   od->naviframe = nd;
+   naviframes = eina_list_append(naviframes, nd);
+
+   return nd;
+}
+
+static void
+_ea_naviframe_data_free(Ea_Naviframe_Data *nd)
+{
+   Ea_Naviframe_Page *page;
+
+   naviframes = eina_list_remove(naviframes, nd);
+   if (nd->idler) ecore_idler_del(nd->idler);
+   EINA_LIST_FREE(nd->pages, page)
+     _ea_naviframe_page_free(page);
+   _ea_mem_free(EA_MEMORY_PAGE, nd, sizeof(Ea_Naviframe_Data));
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_naviframe_object_del(Ea_Object_Data *od)
+{
+   Ea_Naviframe_Data *nd = od->naviframe;
+
+   od->naviframe = NULL;
+   _ea_naviframe_data_free(nd);
+}
+
+//Drop the prebuilt pages. They are built again after the next page get.
+void
+_ea_naviframe_trim(void)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+   Eina_List *l, *l2;
+
+   EINA_LIST_FOREACH(naviframes, l, nd)
+     {
+        if (nd->idler)
+          {
+             ecore_idler_del(nd->idler);
+             nd->idler = NULL;
+          }
+        EINA_LIST_FOREACH(nd->pages, l2, page)
+          _ea_naviframe_page_discard(page);
+     }
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Eina_Bool
+ea_naviframe_page_prebuild_add(Evas_Object *naviframe, const char *name, Ea_Naviframe_Page_Build_Cb func, const void *data)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+
+   if (!naviframe || !name || !func) return EINA_FALSE;
+
+   nd = _ea_naviframe_data_add(naviframe);
+   if (!nd) return EINA_FALSE;
+
+   page = _ea_naviframe_page_find(nd, name);
+   if (page)
+     {
+        //A new builder makes the prebuilt content stale.
+        _ea_naviframe_page_discard(page);
+        page->failed = EINA_FALSE;
+     }
+   else
+     {
+        page = _ea_mem_calloc(EA_MEMORY_PAGE, sizeof(Ea_Naviframe_Page));
+        if (!page)
+          {
+             LOGE("Failed to allocate naviframe page");
+             return EINA_FALSE;
+          }
+        page->nd = nd;
+        page->name = eina_stringshare_add(name);
+        nd->pages = eina_list_append(nd->pages, page);
+     }
+   page->func = func;
+   page->data = (void *) data;
+
+   _ea_naviframe_prebuild_schedule(nd);
+
+   return EINA_TRUE;
+}
+
+EXPORT_API void
+ea_naviframe_page_prebuild_del(Evas_Object *naviframe, const char *name)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+
+   if (!name) return;
+   nd = _ea_naviframe_data_get(naviframe);
+   if (!nd) return;
+
+   page = _ea_naviframe_page_find(nd, name);
+   if (!page) return;
+
+   nd->pages = eina_list_remove(nd->pages, page);
+   _ea_naviframe_page_free(page);
+
+   //A slot of the budget may be free for the other pages.
+   _ea_naviframe_prebuild_schedule(nd);
+}
+
+EXPORT_API Evas_Object *
+ea_naviframe_page_get(Evas_Object *naviframe, const char *name)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+   Evas_Object *content;
+
+   if (!name) return NULL;
+   nd = _ea_naviframe_data_get(naviframe);
+   if (!nd) return NULL;
+
+   page = _ea_naviframe_page_find(nd, name);
+   if (!page)
+     {
+        LOGW("The page(%s) hasn't been registered before", name);
+        return NULL;
+     }
+
+   content = _ea_naviframe_page_content_take(page);
+   if (!content) content = page->func(page->data, naviframe);
+
+   //Get the next one ready while the user looks at this one.
+   _ea_naviframe_prebuild_schedule(nd);
+
+   return content;
+}
+
+EXPORT_API void
+ea_naviframe_page_invalidate(Evas_Object *naviframe, const char *name)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+   Eina_List *l;
+
+   nd = _ea_naviframe_data_get(naviframe);
+   if (!nd) return;
+
+   EINA_LIST_FOREACH(nd->pages, l, page)
+     {
+        if (name && strcmp(page->name, name)) continue;
+        _ea_naviframe_page_discard(page);
+        page->failed = EINA_FALSE;
+     }
+
+   _ea_naviframe_prebuild_schedule(nd);
+}
+
+EXPORT_API void
+ea_naviframe_page_prebuild_budget_set(Evas_Object *naviframe, unsigned int budget)
+{
+   Ea_Naviframe_Data *nd;
+   Ea_Naviframe_Page *page;
+   Eina_List *l;
+
+   nd = _ea_naviframe_data_add(naviframe);
+   if (!nd) return;
+
+   nd->budget = budget;
+
+   //Keep the more likely pages within the new budget.
+   EINA_LIST_REVERSE_FOREACH(nd->pages, l, page)
+     {
+        if (nd->built <= nd->budget) break;
+        _ea_naviframe_page_discard(page);
+     }
+
+   _ea_naviframe_prebuild_schedule(nd);
+}
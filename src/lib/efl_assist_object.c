@@ -0,0 +1,96 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+static Eina_Hash *objects = NULL;
+static Ea_Object_Data *last = NULL;   //hot callbacks ask for the same object in a row
+
+static void _ea_object_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
+
+static void
+_ea_object_data_free(Ea_Object_Data *od)
+{
+   evas_object_event_callback_del_full(od->obj, EVAS_CALLBACK_DEL,
+                                       _ea_object_del_cb, od);
+   eina_hash_del_by_key(objects, &od->obj);
+   if (last == od) last = NULL;
+   _ea_mem_free(EA_MEMORY_OBJECT, od, sizeof(Ea_Object_Data));
+}
+
+static void
+_ea_object_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   Ea_Object_Data *od = data;
+
+   if (od->obj_event) _ea_event_object_del(od);
+   if (od->eed) _ea_editfield_object_del(od);
+   if (od->pool_item) _ea_pool_object_del(od);
+   if (od->naviframe) _ea_naviframe_object_del(od);
+   _ea_object_data_free(od);
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+Ea_Object_Data *
+_ea_object_data_get(const Evas_Object *obj)
+{
+   Ea_Object_Data *od;
+
+   if (!obj) return NULL;
+   if (last && (last->obj == obj)) return last;
+   if (!objects) return NULL;
+
+   od = eina_hash_find(objects, &obj);
+   if (od) last = od;
+
+   return od;
+}
+
+Ea_Object_Data *
+_ea_object_data_add(Evas_Object *obj)
+{
+   Ea_Object_Data *od;
+
+   if (!obj) return NULL;
+
+   od = _ea_object_data_get(obj);
+   if (od) return od;
+
+   if (!objects)
+     {
+        objects = eina_hash_pointer_new(NULL);
+        if (!objects)
+          {
+             LOGE("Failed to allocate object table");
+             return NULL;
+          }
+     }
+
+   od = _ea_mem_calloc(EA_MEMORY_OBJECT, sizeof(Ea_Object_Data));
+   if (!od)
+     {
+        LOGE("Failed to allocate object data");
+        return NULL;
+     }
+   od->obj = obj;
+   if (!eina_hash_add(objects, &od->obj, od))
+     {
+        LOGE("Failed to add object data");
+        _ea_mem_free(EA_MEMORY_OBJECT, od, sizeof(Ea_Object_Data));
+        return NULL;
+     }
+   evas_object_event_callback_add(obj, EVAS_CALLBACK_DEL, _ea_object_del_cb, od);
+   last = od;
+
+   return od;
+}
+
+void
+_ea_object_data_release(Ea_Object_Data *od)
+{
+   if (!od || od->obj_event || od->eed || od->pool_item ||
+       od->naviframe) return;
+
+   _ea_object_data_free(od);
+}
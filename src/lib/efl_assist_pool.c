@@ -0,0 +1,167 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+typedef enum _Ea_Pool_Kind
+{
+   EA_POOL_POPUP,
+   EA_POOL_CTXPOPUP
+} Ea_Pool_Kind;
+
+struct _Ea_Pool_Item
+{
+   Evas_Object *obj;
+   Evas_Object *parent;
+   const char *name;   //stringshared
+   Ea_Pool_Kind kind;
+   Ea_Pool_Reset_Cb reset;
+   void *data;
+   Eina_Bool in_use : 1;
+};
+
+//The pooled objects of all parents. There are only a few per application.
+static Eina_List *items = NULL;
+
+static void
+_ea_pool_item_free(Ea_Pool_Item *item)
+{
+   items = eina_list_remove(items, item);
+   eina_stringshare_del(item->name);
+   _ea_mem_free(EA_MEMORY_POOL, item, sizeof(Ea_Pool_Item));
+}
+
+static void
+_ea_pool_item_release(Ea_Pool_Item *item)
+{
+   if (!item->in_use) return;
+
+   item->in_use = EINA_FALSE;
+   evas_object_hide(item->obj);
+   elm_object_focus_set(item->obj, EINA_FALSE);
+
+   //Undo what the last user changed, so the next one gets it as built.
+   if (item->reset) item->reset(item->data, item->obj);
+}
+
+static void
+_ea_pool_ctxpopup_dismissed_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   _ea_pool_item_release(data);
+}
+
+static Evas_Object *
+_ea_pool_get(Ea_Pool_Kind kind, Evas_Object *parent, const char *name,
+             Ea_Pool_Build_Cb func, Ea_Pool_Reset_Cb reset, const void *data)
+{
+   Ea_Pool_Item *item;
+   Ea_Object_Data *od;
+   Evas_Object *obj;
+   Eina_List *l;
+
+   if (!parent || !name || !func) return NULL;
+
+   EINA_LIST_FOREACH(items, l, item)
+     {
+        if ((item->parent != parent) || (item->kind != kind)) continue;
+        if (strcmp(item->name, name)) continue;
+
+        item->in_use = EINA_TRUE;
+        return item->obj;
+     }
+
+   if (kind == EA_POOL_CTXPOPUP) obj = elm_ctxpopup_add(parent);
+   else obj = elm_popup_add(parent);
+   if (!obj) return NULL;
+
+   func((void *) data, obj);
+
+   od = _ea_object_data_add(obj);
+   if (!od) return obj;
+
+   item = _ea_mem_calloc(EA_MEMORY_POOL, sizeof(Ea_Pool_Item));
+   if (!item)
+     {
+        LOGE("Failed to allocate pool item");
+        _ea_object_data_release(od);
+        return obj;
+     }
+   item->obj = obj;
+   item->parent = parent;
+   item->name = eina_stringshare_add(name);
+   item->kind = kind;
+   item->reset = reset;
+   item->data = (void *) data;
+   item->in_use = EINA_TRUE;
+   od->pool_item = item;
+   items = eina_list_prepend(items, item);
+
+   //The ctxpopup hides itself when it is dismissed.
+   if (kind == EA_POOL_CTXPOPUP)
+     evas_object_smart_callback_add(obj, "dismissed",
+                                    _ea_pool_ctxpopup_dismissed_cb, item);
+
+   return obj;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_pool_object_del(Ea_Object_Data *od)
+{
+   Ea_Pool_Item *item = od->pool_item;
+
+   od->pool_item = NULL;
+   _ea_pool_item_free(item);
+}
+
+//Delete the pooled objects which are not shown. They are built again on
+//the next ea_popup_pool_get() or ea_ctxpopup_pool_get().
+void
+_ea_pool_trim(void)
+{
+   Ea_Pool_Item *item;
+   Eina_List *l, *l_next;
+
+   EINA_LIST_FOREACH_SAFE(items, l, l_next, item)
+     {
+        if (item->in_use) continue;
+        //The DEL callback frees the item.
+        evas_object_del(item->obj);
+     }
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Evas_Object *
+ea_popup_pool_get(Evas_Object *parent, const char *name, Ea_Pool_Build_Cb func, Ea_Pool_Reset_Cb reset, const void *data)
+{
+   return _ea_pool_get(EA_POOL_POPUP, parent, name, func, reset, data);
+}
+
+EXPORT_API Evas_Object *
+ea_ctxpopup_pool_get(Evas_Object *parent, const char *name, Ea_Pool_Build_Cb func, Ea_Pool_Reset_Cb reset, const void *data)
+{
+   return _ea_pool_get(EA_POOL_CTXPOPUP, parent, name, func, reset, data);
+}
+
+EXPORT_API void
+ea_pool_object_release(Evas_Object *obj)
+{
+   Ea_Object_Data *od = _ea_object_data_get(obj);
+
+   if (!od || !od->pool_item)
+     {
+        //Not pooled. Behave like ea_popup_back_cb().
+        evas_object_del(obj);
+        return;
+     }
+
+   //The dismissed callback releases the ctxpopup after its hiding effect.
+   if ((od->pool_item->kind == EA_POOL_CTXPOPUP) && evas_object_visible_get(obj))
+     elm_ctxpopup_dismiss(obj);
+   else
+     _ea_pool_item_release(od->pool_item);
+}
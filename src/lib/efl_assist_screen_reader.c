@@ -2,170 +2,544 @@
 #include "efl_assist_private.h"
 #include <Ecore_X.h>
 #include <vconf.h>
-#include <tts.h>
 #define UNAVAILABLE_TEXT "Screen reader is unavailable during using this application. You can press home or back key to go back to home screen."
 
-static tts_h tts = NULL;
+#ifndef EA_VCONF_SONAME
+# define EA_VCONF_SONAME "libvconf.so.0"
+#endif
+#ifndef EA_ECORE_X_SONAME
+# define EA_ECORE_X_SONAME "libecore_x.so.1"
+#endif
 
-static void _tts_shutdown(void)
+//vconf and Ecore_X are loaded when the screen reader is used for the first
+//time, so the processes which don't use it don't load them at startup.
+static struct
 {
-   int ret = 0;
-   if (tts)
+   __typeof__(vconf_get_bool) *vconf_get_bool;
+   __typeof__(vconf_notify_key_changed) *vconf_notify_key_changed;
+   __typeof__(vconf_ignore_key_changed) *vconf_ignore_key_changed;
+   __typeof__(vconf_keynode_get_bool) *vconf_keynode_get_bool;
+} vconf_api;
+
+static const Ea_Dl_Symbol vconf_symbols[] =
+{
+   EA_DL_SYMBOL(vconf_api, vconf_get_bool),
+   EA_DL_SYMBOL(vconf_api, vconf_notify_key_changed),
+   EA_DL_SYMBOL(vconf_api, vconf_ignore_key_changed),
+   EA_DL_SYMBOL(vconf_api, vconf_keynode_get_bool),
+   { NULL, NULL }
+};
+
+static Ea_Dl_Lib vconf_lib = { EA_VCONF_SONAME, vconf_symbols, NULL, EINA_FALSE };
+
+static struct
+{
+   __typeof__(ecore_x_window_prop_card32_set) *ecore_x_window_prop_card32_set;
+   __typeof__(ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL) *ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL;
+} ecore_x_api;
+
+static const Ea_Dl_Symbol ecore_x_symbols[] =
+{
+   EA_DL_SYMBOL(ecore_x_api, ecore_x_window_prop_card32_set),
+   EA_DL_SYMBOL(ecore_x_api, ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL),
+   { NULL, NULL }
+};
+
+static Ea_Dl_Lib ecore_x_lib = { EA_ECORE_X_SONAME, ecore_x_symbols, NULL, EINA_FALSE };
+
+//Utterances waiting for the engine. Only a few recent ones are worth saying.
+#define EA_TTS_QUEUE_MAX 16
+
+typedef struct _Ea_Utterance
+{
+   const char *text;   //stringshared
+   Ea_Screen_Reader_Priority priority;
+} Ea_Utterance;
+
+//One handle for the process. It is prepared at the first use and kept until
+//the library is unloaded, so the later announcements don't wait for the engine.
+static const Ea_Tts_Backend *tts = NULL;
+static Eina_Bool tts_ready = EINA_FALSE;
+
+//The engine gets one utterance at a time, the rest wait in the queue sorted
+//by priority, so the queue can still be reordered and pruned.
+static Eina_List *tts_queue = NULL;
+static Ea_Utterance *tts_current = NULL;
+static int tts_current_id = 0;
+
+typedef struct _Ea_Screen_Reader_Callback
+{
+   Ea_Screen_Reader_Changed_Cb func;
+   void *data;
+   Eina_Bool delete_me : 1;
+} Ea_Screen_Reader_Callback;
+
+//The accessibility setting is read once and then followed by notification,
+//so the callers never wait for the settings daemon.
+static Eina_Bool tts_enabled = EINA_FALSE;
+static Eina_Bool tts_watching = EINA_FALSE;
+static Eina_List *changed_callbacks = NULL;
+static int changed_walking = 0;
+
+typedef struct _Ea_Screen_Reader_Window
+{
+   Evas_Object *win;
+   Evas_Object *popup;
+   Ecore_X_Window xwin;
+   int prop;              //last ILLUME_ACCESS_CONTROL value set, -1 if none
+   Eina_Bool support : 1;
+} Ea_Screen_Reader_Window;
+
+static Eina_List *windows = NULL;
+static int supporting_windows = 0;
+
+static void _utterance_free(Ea_Utterance *utterance)
+{
+   eina_stringshare_del(utterance->text);
+   _ea_mem_free(EA_MEMORY_TTS, utterance, sizeof(Ea_Utterance));
+}
+
+static void _tts_queue_next(void)
+{
+   Ea_Utterance *utterance;
+   int u_id = 0;
+
+   if (!tts_ready || tts_current) return;
+
+   while (tts_queue)
      {
-        /* check current state */
-        tts_state_e state;
-        tts_get_state(tts, &state);
-        if (state == TTS_STATE_PLAYING || state == TTS_STATE_PAUSED)
-          {
-             ret = tts_stop(tts);
-             if (TTS_ERROR_NONE != ret)
-               {
-                  fprintf(stderr, "Fail to stop handle : result(%d)", ret);
-                  return;
-               }
-          }
+        utterance = eina_list_data_get(tts_queue);
+        tts_queue = eina_list_remove_list(tts_queue, tts_queue);
 
-        /* it is possible to try to shutdown before the state is ready,
-           because tts_prepare(); works Asynchronously. see elm_modapi_init(): */
-        if (state == TTS_STATE_READY)
+        if (!tts->text_add(utterance->text, &u_id))
           {
-             ret = tts_unprepare(tts);
-             if (TTS_ERROR_NONE != ret)
-               {
-                  fprintf(stderr, "Fail to unprepare handle : result(%d)", ret);
-                  return;
-               }
-
-             ret = tts_unset_state_changed_cb(tts);
-             if (TTS_ERROR_NONE != ret)
-               {
-                  fprintf(stderr, "Fail to set callback : result(%d)", ret);
-                  return;
-               }
+             _utterance_free(utterance);
+             continue;
           }
+        tts_current = utterance;
+        tts_current_id = u_id;
+        break;
+     }
+   if (!tts_current) return;
 
-        ret = tts_destroy(tts);
-        if (TTS_ERROR_NONE != ret)
-          {
-             fprintf(stderr, "Fail to destroy handle : result(%d)", ret);
-             return;
-          }
+   if (tts->state_get() != EA_TTS_STATE_PLAYING) tts->play();
+}
 
-        if (tts) tts = NULL;
+static void _tts_current_stop(void)
+{
+   Ea_Tts_State state;
+
+   if (tts_current)
+     {
+        _utterance_free(tts_current);
+        tts_current = NULL;
      }
+
+   if (!tts) return;
+
+   state = tts->state_get();
+   if (state == EA_TTS_STATE_PLAYING || state == EA_TTS_STATE_PAUSED)
+     tts->stop();
 }
 
-void _tts_state_changed_cb(tts_h tts, tts_state_e previous, tts_state_e current, void* data)
+//Remove the queued utterances whose priority is lower than (or, with
+//@p inclusive, the same as) @p priority.
+static void _tts_queue_prune(Ea_Screen_Reader_Priority priority, Eina_Bool inclusive)
 {
-   int ret = 0;
-   int u_id = 0;
+   Ea_Utterance *utterance;
+   Eina_List *l, *l_next;
+
+   EINA_LIST_FOREACH_SAFE(tts_queue, l, l_next, utterance)
+     {
+        if ((utterance->priority > priority) ||
+            ((utterance->priority == priority) && !inclusive))
+          continue;
+        tts_queue = eina_list_remove_list(tts_queue, l);
+        _utterance_free(utterance);
+     }
+}
+
+static void _tts_utterance_completed_cb(int utt_id)
+{
+   if (!tts_current || (utt_id != tts_current_id)) return;
+
+   _utterance_free(tts_current);
+   tts_current = NULL;
+   _tts_queue_next();
+}
+
+static void _tts_state_changed_cb(Ea_Tts_State previous, Ea_Tts_State current)
+{
+   if (EA_TTS_STATE_CREATED == previous && EA_TTS_STATE_READY == current)
+     {
+        tts_ready = EINA_TRUE;
+        _tts_queue_next();
+     }
+   else if (EA_TTS_STATE_CREATED == current)
+     tts_ready = EINA_FALSE;
+}
+
+static Eina_Bool _tts_init(void)
+{
+   const Ea_Tts_Backend *backend;
+
+   if (tts) return EINA_TRUE;
 
-   if (TTS_STATE_CREATED == previous && TTS_STATE_READY == current)
+   backend = _ea_tts_backend_get();
+   if (!backend->init(_tts_state_changed_cb, _tts_utterance_completed_cb))
+     return EINA_FALSE;
+   tts = backend;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool _tts_speak(const char *text, Ea_Screen_Reader_Priority priority,
+                            unsigned int flags)
+{
+   Ea_Utterance *utterance, *oldest = NULL;
+   Eina_List *l, *pos = NULL;
+   const char *str;
+
+   if (!_tts_init()) return EINA_FALSE;
+
+   str = eina_stringshare_add(text);
+
+   if (flags & EA_SCREEN_READER_SPEAK_INTERRUPT)
+     {
+        _tts_queue_prune(priority, EINA_TRUE);
+        if (tts_current && (tts_current->priority <= priority))
+          _tts_current_stop();
+     }
+   else
+     _tts_queue_prune(priority, EINA_FALSE);
+
+   //Merge the duplicates. Being said or waiting, it will be said once.
+   if (tts_current && (tts_current->text == str))
+     {
+        eina_stringshare_del(str);
+        return EINA_TRUE;
+     }
+   EINA_LIST_FOREACH(tts_queue, l, utterance)
      {
-        ret = tts_add_text(tts, UNAVAILABLE_TEXT, NULL, TTS_VOICE_TYPE_AUTO,
-                           TTS_SPEED_AUTO, &u_id);
-        if (TTS_ERROR_NONE != ret)
+        if (utterance->text == str)
           {
-             fprintf(stderr, "Fail to add kept text : ret(%d)\n", ret);
+             eina_stringshare_del(str);
+             return EINA_TRUE;
           }
+        if (utterance->priority >= priority) pos = l;
+        if (!oldest || (utterance->priority < oldest->priority))
+          oldest = utterance;
+     }
 
-        ret = tts_play(tts);
-        if (TTS_ERROR_NONE != ret)
+   //The queue is full. Drop the oldest one of the lowest priority.
+   if (eina_list_count(tts_queue) >= EA_TTS_QUEUE_MAX)
+     {
+        if (oldest->priority > priority)
           {
-             fprintf(stderr, "Fail to play TTS : ret(%d)\n", ret);
+             eina_stringshare_del(str);
+             return EINA_FALSE;
           }
+        if (pos && (eina_list_data_get(pos) == oldest))
+          pos = eina_list_prev(pos);
+        tts_queue = eina_list_remove(tts_queue, oldest);
+        _utterance_free(oldest);
+     }
+
+   utterance = _ea_mem_calloc(EA_MEMORY_TTS, sizeof(Ea_Utterance));
+   if (!utterance)
+     {
+        LOGE("Failed to allocate utterance");
+        eina_stringshare_del(str);
+        return EINA_FALSE;
      }
+   utterance->text = str;
+   utterance->priority = priority;
+
+   if (pos)
+     tts_queue = eina_list_append_relative_list(tts_queue, utterance, pos);
+   else
+     tts_queue = eina_list_prepend(tts_queue, utterance);
+
+   _tts_queue_next();
+
+   return EINA_TRUE;
 }
 
-static void _tts_init(void)
+static void _tts_stop(void)
 {
-   int ret = 0;
+   Ea_Utterance *utterance;
 
-   ret = tts_create(&tts);
-   if (TTS_ERROR_NONE != ret)
+   EINA_LIST_FREE(tts_queue, utterance)
+     _utterance_free(utterance);
+   _tts_current_stop();
+}
+
+static void _changed_callbacks_call(void)
+{
+   Ea_Screen_Reader_Callback *callback;
+   Eina_List *l, *l_next;
+
+   changed_walking++;
+   EINA_LIST_FOREACH(changed_callbacks, l, callback)
      {
-        fprintf(stderr, "Fail to get handle : result(%d)", ret);
-        return;
+        if (callback->delete_me) continue;
+        callback->func(callback->data, tts_enabled);
      }
+   changed_walking--;
+
+   if (changed_walking) return;
 
-   ret = tts_set_state_changed_cb(tts, _tts_state_changed_cb, NULL);
-   if (TTS_ERROR_NONE != ret)
+   EINA_LIST_FOREACH_SAFE(changed_callbacks, l, l_next, callback)
      {
-        fprintf(stderr, "Fail to set callback : result(%d)", ret);
-        return;
+        if (!callback->delete_me) continue;
+        changed_callbacks = eina_list_remove_list(changed_callbacks, l);
+        _ea_mem_free(EA_MEMORY_CALLBACK, callback, sizeof(Ea_Screen_Reader_Callback));
+     }
+}
+
+static void _tts_enabled_changed_cb(keynode_t *node, void *data)
+{
+   Eina_Bool enabled = !!vconf_api.vconf_keynode_get_bool(node);
+
+   if (enabled == tts_enabled) return;
+   tts_enabled = enabled;
+
+   if (!tts_enabled) _tts_stop();
+   _changed_callbacks_call();
+}
+
+static Eina_Bool _tts_enabled_get(void)
+{
+   int tts_val = 0;
+
+   if (tts_watching) return tts_enabled;
+
+   //The local backend stands in for the platform TTS, its setting included.
+   if (_ea_tts_backend_get() == &_ea_tts_local_backend) return EINA_TRUE;
+
+   if (!_ea_dl_load(&vconf_lib)) return EINA_FALSE;
+
+   if (vconf_api.vconf_notify_key_changed(VCONFKEY_SETAPPL_ACCESSIBILITY_TTS,
+                                _tts_enabled_changed_cb, NULL) != 0)
+     {
+        //Without the notification, the cached value can't be trusted.
+        LOGW("Fail to watch the accessibility setting");
+        if (vconf_api.vconf_get_bool(VCONFKEY_SETAPPL_ACCESSIBILITY_TTS, &tts_val) != 0)
+          return EINA_FALSE;
+        return !!tts_val;
      }
+   tts_watching = EINA_TRUE;
+
+   if (vconf_api.vconf_get_bool(VCONFKEY_SETAPPL_ACCESSIBILITY_TTS, &tts_val) != 0)
+     LOGW("Fail to get the accessibility setting");
+   tts_enabled = !!tts_val;
+
+   return tts_enabled;
+}
+
+static void _window_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
+static void _timeout_cb(void *data, Evas_Object *obj, void *event_info);
 
-   ret = tts_set_mode(tts, TTS_MODE_SCREEN_READER);
-   if (TTS_ERROR_NONE != ret)
+//Elementary has one access switch for the process. The windows keep their
+//own state and the switch follows them, so it is flipped only when the
+//first window turns access on or the last one turns it off.
+static Ea_Screen_Reader_Window *_window_get(Evas_Object *win, Eina_Bool create)
+{
+   Ea_Screen_Reader_Window *w;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(windows, l, w)
      {
-        fprintf(stderr, "Fail to set mode : result(%d)", ret);
-        return;
+        if (w->win == win) return w;
      }
+   if (!create) return NULL;
 
-   ret = tts_prepare(tts);
-   if (TTS_ERROR_NONE != ret)
+   w = _ea_mem_calloc(EA_MEMORY_TTS, sizeof(Ea_Screen_Reader_Window));
+   if (!w)
      {
-        fprintf(stderr, "Fail to prepare handle : result(%d)", ret);
-        return;
+        LOGE("Failed to allocate screen reader window");
+        return NULL;
      }
+   w->win = win;
+   w->prop = -1;
+   evas_object_event_callback_add(win, EVAS_CALLBACK_DEL, _window_del_cb, w);
+   windows = eina_list_append(windows, w);
+
+   return w;
+}
+
+static void _window_support_update(Ea_Screen_Reader_Window *w, Eina_Bool support)
+{
+   if (w->support == support) return;
+   w->support = support;
+
+   if (support) supporting_windows++;
+   else supporting_windows--;
+
+   if (!!elm_config_access_get() != (supporting_windows > 0))
+     elm_config_access_set(supporting_windows > 0);
+}
+
+static void _window_prop_set(Ea_Screen_Reader_Window *w, Ecore_X_Window xwin, unsigned int val)
+{
+   //The property is only set by us. Skip the round trip if it is the same.
+   if ((w->xwin == xwin) && (w->prop == (int)val)) return;
+
+   if (!_ea_dl_load(&ecore_x_lib)) return;
+
+   ecore_x_api.ecore_x_window_prop_card32_set
+     (xwin, *ecore_x_api.ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL, &val, 1);
+   w->xwin = xwin;
+   w->prop = val;
+}
+
+static void _popup_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   Ea_Screen_Reader_Window *w = data;
+
+   //The notice may go away with the back key or the window as well.
+   w->popup = NULL;
+}
+
+//Forget the notice without deleting it, the window record is going away.
+static void _window_popup_unset(Ea_Screen_Reader_Window *w)
+{
+   if (!w->popup) return;
+
+   evas_object_event_callback_del_full(w->popup, EVAS_CALLBACK_DEL,
+                                       _popup_del_cb, w);
+   evas_object_smart_callback_del_full(w->popup, "timeout", _timeout_cb, w);
+   w->popup = NULL;
+}
+
+static void _window_del_cb(void *data, Evas *e, Evas_Object *obj, void *event_info)
+{
+   Ea_Screen_Reader_Window *w = data;
+
+   _window_popup_unset(w);
+   _window_support_update(w, EINA_FALSE);
+   windows = eina_list_remove(windows, w);
+   _ea_mem_free(EA_MEMORY_TTS, w, sizeof(Ea_Screen_Reader_Window));
 }
 
 static void _timeout_cb(void *data, Evas_Object *obj, void *event_info)
 {
+   Ea_Screen_Reader_Window *w = data;
    Ecore_X_Window xwin;
-   unsigned int val;
 
-   xwin = elm_win_xwindow_get(data);
+   evas_object_del(obj);
+
+   xwin = elm_win_xwindow_get(w->win);
    if (!xwin) return;
 
-   evas_object_del(obj);
+   _window_prop_set(w, xwin, 2);
+
+   _tts_stop();
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+void
+_ea_screen_reader_shutdown(void)
+{
+   Ea_Screen_Reader_Callback *callback;
+   Ea_Screen_Reader_Window *w;
+   Ea_Utterance *utterance;
+
+   if (tts_watching)
+     {
+        vconf_api.vconf_ignore_key_changed(VCONFKEY_SETAPPL_ACCESSIBILITY_TTS,
+                                 _tts_enabled_changed_cb);
+        tts_watching = EINA_FALSE;
+     }
+   EINA_LIST_FREE(changed_callbacks, callback)
+     _ea_mem_free(EA_MEMORY_CALLBACK, callback, sizeof(Ea_Screen_Reader_Callback));
+
+   EINA_LIST_FREE(windows, w)
+     {
+        evas_object_event_callback_del_full(w->win, EVAS_CALLBACK_DEL,
+                                            _window_del_cb, w);
+        _window_popup_unset(w);
+        _ea_mem_free(EA_MEMORY_TTS, w, sizeof(Ea_Screen_Reader_Window));
+     }
+   supporting_windows = 0;
+
+   EINA_LIST_FREE(tts_queue, utterance)
+     _utterance_free(utterance);
+   if (tts_current)
+     {
+        _utterance_free(tts_current);
+        tts_current = NULL;
+     }
 
-   val = 2;
-   ecore_x_window_prop_card32_set
-     (xwin, ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL, &val, 1);
+   if (!tts) return;
 
-   _tts_shutdown();
+   tts->shutdown();
+   tts = NULL;
+   tts_ready = EINA_FALSE;
 }
 
+//The handle is prepared again by the next announcement.
+void
+_ea_screen_reader_trim(void)
+{
+   if (!tts || tts_current || tts_queue) return;
+
+   tts->shutdown();
+   tts = NULL;
+   tts_ready = EINA_FALSE;
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
 EAPI Eina_Bool
 ea_screen_reader_support_set(Evas_Object *win, Eina_Bool support)
 {
+   Ea_Screen_Reader_Window *w;
    Ecore_X_Window xwin;
-   unsigned int val;
-   int tts_val;
-   Evas_Object *base;
-   Evas_Object *body;
    Evas_Object *popup;
 
-   if (vconf_get_bool(VCONFKEY_SETAPPL_ACCESSIBILITY_TTS, &tts_val) != 0)
-     return EINA_FALSE;
-
-   if (!tts_val) return EINA_FALSE;
+   if (!_tts_enabled_get()) return EINA_FALSE;
 
    if (!win) return EINA_FALSE;
 
    xwin = elm_win_xwindow_get(win);
    if (!xwin) return EINA_FALSE;
 
+   w = _window_get(win, EINA_TRUE);
+   if (!w) return EINA_FALSE;
+
    if (support)
      {
-        val = 0;
-        elm_config_access_set(EINA_TRUE);
-
-        ecore_x_window_prop_card32_set
-          (xwin, ECORE_X_ATOM_E_ILLUME_ACCESS_CONTROL, &val, 1);
+        _window_support_update(w, EINA_TRUE);
+        _window_prop_set(w, xwin, 0);
      }
    else
      {
-        elm_config_access_set(EINA_FALSE);
+        _window_support_update(w, EINA_FALSE);
+
+        //An explicit opt-out turns access off even if this window never
+        //turned it on, e.g. when the system setting did.
+        if (!supporting_windows && elm_config_access_get())
+          elm_config_access_set(EINA_FALSE);
+
+        //The notice is already shown.
+        if (w->popup) return EINA_TRUE;
 
         popup = elm_popup_add(win);
         evas_object_size_hint_weight_set(popup, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
         elm_object_text_set(popup, UNAVAILABLE_TEXT);
         elm_popup_timeout_set(popup, 12.0);
-        evas_object_smart_callback_add(popup, "timeout", _timeout_cb, win);
+        evas_object_smart_callback_add(popup, "timeout", _timeout_cb, w);
+        evas_object_event_callback_add(popup, EVAS_CALLBACK_DEL, _popup_del_cb, w);
+        w->popup = popup;
 
-        _tts_init();
+        _tts_speak(UNAVAILABLE_TEXT, EA_SCREEN_READER_PRIORITY_HIGH,
+                   EA_SCREEN_READER_SPEAK_INTERRUPT);
         evas_object_show(popup);
      }
 
@@ -177,3 +551,83 @@ ea_screen_reader_support_get()
 {
    return elm_config_access_get();
 }
+
+EAPI Eina_Bool
+ea_screen_reader_window_support_get(const Evas_Object *win)
+{
+   Ea_Screen_Reader_Window *w;
+
+   w = _window_get((Evas_Object *) win, EINA_FALSE);
+   if (!w) return EINA_FALSE;
+
+   return w->support;
+}
+
+EAPI Eina_Bool
+ea_screen_reader_enabled_get(void)
+{
+   return _tts_enabled_get();
+}
+
+EAPI void
+ea_screen_reader_changed_cb_add(Ea_Screen_Reader_Changed_Cb func, const void *data)
+{
+   Ea_Screen_Reader_Callback *callback;
+
+   if (!func) return;
+
+   //Start watching the setting before the first change comes.
+   _tts_enabled_get();
+
+   callback = _ea_mem_calloc(EA_MEMORY_CALLBACK, sizeof(Ea_Screen_Reader_Callback));
+   if (!callback)
+     {
+        LOGE("Failed to allocate screen reader callback");
+        return;
+     }
+   callback->func = func;
+   callback->data = (void *) data;
+
+   changed_callbacks = eina_list_append(changed_callbacks, callback);
+}
+
+EAPI void *
+ea_screen_reader_changed_cb_del(Ea_Screen_Reader_Changed_Cb func)
+{
+   Ea_Screen_Reader_Callback *callback;
+   Eina_List *l;
+   void *data;
+
+   EINA_LIST_REVERSE_FOREACH(changed_callbacks, l, callback)
+     {
+        if (callback->delete_me || (callback->func != func)) continue;
+
+        data = callback->data;
+        if (changed_walking)
+          callback->delete_me = EINA_TRUE;
+        else
+          {
+             changed_callbacks = eina_list_remove_list(changed_callbacks, l);
+             _ea_mem_free(EA_MEMORY_CALLBACK, callback, sizeof(Ea_Screen_Reader_Callback));
+          }
+        return data;
+     }
+
+   LOGW("This callback(%p) hasn't been registered before", func);
+   return NULL;
+}
+
+EAPI Eina_Bool
+ea_screen_reader_speak(const char *text, Ea_Screen_Reader_Priority priority, unsigned int flags)
+{
+   if (!text || !text[0]) return EINA_FALSE;
+   if (!_tts_enabled_get()) return EINA_FALSE;
+
+   return _tts_speak(text, priority, flags);
+}
+
+EAPI void
+ea_screen_reader_speak_cancel(void)
+{
+   _tts_stop();
+}
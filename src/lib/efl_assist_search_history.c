@@ -0,0 +1,821 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define EA_SEARCH_HISTORY_MAGIC 0x48534145   /* "EASH" */
+#define EA_SEARCH_HISTORY_VERSION 1
+#define EA_SEARCH_HISTORY_SAVE_DELAY 1.0
+
+/* File layout:
+ *    Ea_Search_History_Header
+ *    Ea_Search_History_Record[count], sorted by the folded key
+ *    strings (folded key and text of each record, NUL terminated)
+ * All offsets are from the beginning of the file. */
+typedef struct _Ea_Search_History_Header
+{
+   uint32_t magic;
+   uint32_t version;
+   uint32_t count;
+   uint32_t stamp;
+} Ea_Search_History_Header;
+
+typedef struct _Ea_Search_History_Record
+{
+   uint32_t key;
+   uint32_t text;
+   uint32_t stamp;
+} Ea_Search_History_Record;
+
+//Change which is not written to the file yet.
+typedef struct _Ea_Search_History_Item
+{
+   const char *key;
+   const char *text;   //NULL if removed
+   unsigned int stamp;
+} Ea_Search_History_Item;
+
+typedef struct _Ea_Search_History_Entry
+{
+   char *key;
+   char *text;
+   unsigned int stamp;
+} Ea_Search_History_Entry;
+
+typedef struct _Ea_Search_History_Save
+{
+   Ea_Search_History *hist;
+   char *path;
+   Ea_Search_History_Entry *entries;
+   unsigned int count;
+   unsigned int max_count;
+   unsigned int stamp;
+   Eina_List *saved_items;
+   Eina_Bool ok : 1;
+} Ea_Search_History_Save;
+
+typedef struct _Ea_Search_History_Match
+{
+   const char *text;
+   unsigned int stamp;
+} Ea_Search_History_Match;
+
+typedef struct _Ea_Search_History_Lookup
+{
+   const char *key;
+   size_t key_len;
+   Ea_Search_History_Match *matches;
+   unsigned int count;
+   unsigned int max_count;
+} Ea_Search_History_Lookup;
+
+struct _Ea_Search_History
+{
+   char *path;
+   unsigned int max_count;
+   unsigned char *map;
+   size_t map_size;
+   unsigned int map_count;
+   Eina_Hash *items;
+   unsigned int stamp;
+   Ecore_Timer *save_timer;
+   Ecore_Thread *save_thread;
+   Eina_Bool dirty : 1;
+   Eina_Bool cleared : 1;
+   Eina_Bool delete_me : 1;
+};
+
+static void _ea_search_history_save_start(Ea_Search_History *hist);
+static Eina_Bool _ea_search_history_save_timer_cb(void *data);
+
+static void
+_ea_search_history_item_free(void *data)
+{
+   Ea_Search_History_Item *item = data;
+
+   eina_stringshare_del(item->key);
+   eina_stringshare_del(item->text);
+   free(item);
+}
+
+static void
+_ea_search_history_map_close(Ea_Search_History *hist)
+{
+   if (hist->map) munmap(hist->map, hist->map_size);
+   hist->map = NULL;
+   hist->map_size = 0;
+   hist->map_count = 0;
+}
+
+static void
+_ea_search_history_map_open(Ea_Search_History *hist)
+{
+   const Ea_Search_History_Header *header;
+   struct stat st;
+   void *map;
+   int fd;
+
+   fd = open(hist->path, O_RDONLY);
+   if (fd < 0) return;
+
+   if ((fstat(fd, &st) < 0) ||
+       (st.st_size < (off_t) sizeof(Ea_Search_History_Header)) ||
+       (st.st_size > UINT32_MAX))
+     {
+        close(fd);
+        return;
+     }
+
+   map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED)
+     {
+        LOGW("Failed to map search history(%s)", hist->path);
+        return;
+     }
+
+   //Check the validation. The strings are read in place, so the file must
+   //end with NUL.
+   header = map;
+   if ((header->magic != EA_SEARCH_HISTORY_MAGIC) ||
+       (header->version != EA_SEARCH_HISTORY_VERSION) ||
+       (header->count > (st.st_size - sizeof(Ea_Search_History_Header)) /
+                        sizeof(Ea_Search_History_Record)) ||
+       (((const char *) map)[st.st_size - 1] != '\0'))
+     {
+        LOGW("Search history(%s) is corrupted", hist->path);
+        munmap(map, st.st_size);
+        return;
+     }
+
+   hist->map = map;
+   hist->map_size = st.st_size;
+   hist->map_count = header->count;
+   if (header->stamp > hist->stamp) hist->stamp = header->stamp;
+}
+
+static inline const Ea_Search_History_Record *
+_ea_search_history_record_get(const Ea_Search_History *hist, unsigned int i)
+{
+   return ((const Ea_Search_History_Record *)
+           (hist->map + sizeof(Ea_Search_History_Header))) + i;
+}
+
+static inline const char *
+_ea_search_history_string_get(const Ea_Search_History *hist, uint32_t offset)
+{
+   if (offset >= hist->map_size) return "";
+   return (const char *) hist->map + offset;
+}
+
+static unsigned int
+_ea_search_history_lower_bound(const Ea_Search_History *hist, const char *key,
+                               size_t key_len)
+{
+   const Ea_Search_History_Record *record;
+   unsigned int lo = 0, hi = hist->map_count, mid;
+
+   while (lo < hi)
+     {
+        mid = lo + (hi - lo) / 2;
+        record = _ea_search_history_record_get(hist, mid);
+        if (strncmp(_ea_search_history_string_get(hist, record->key),
+                    key, key_len) < 0)
+          lo = mid + 1;
+        else
+          hi = mid;
+     }
+
+   return lo;
+}
+
+//Keep the most recently used matches, sorted by the stamp.
+static void
+_ea_search_history_match_add(Ea_Search_History_Lookup *lookup,
+                             const char *text, unsigned int stamp)
+{
+   unsigned int i;
+
+   if (lookup->count == lookup->max_count)
+     {
+        if (lookup->matches[lookup->count - 1].stamp >= stamp) return;
+        lookup->count--;
+     }
+
+   for (i = lookup->count; i > 0; i--)
+     {
+        if (lookup->matches[i - 1].stamp >= stamp) break;
+        lookup->matches[i] = lookup->matches[i - 1];
+     }
+   lookup->matches[i].text = text;
+   lookup->matches[i].stamp = stamp;
+   lookup->count++;
+}
+
+static Eina_Bool
+_ea_search_history_items_lookup_cb(const Eina_Hash *hash, const void *key,
+                                   void *data, void *fdata)
+{
+   Ea_Search_History_Item *item = data;
+   Ea_Search_History_Lookup *lookup = fdata;
+
+   if (!item->text) return EINA_TRUE;
+   if (strncmp(item->key, lookup->key, lookup->key_len)) return EINA_TRUE;
+
+   _ea_search_history_match_add(lookup, item->text, item->stamp);
+
+   return EINA_TRUE;
+}
+
+static int
+_ea_search_history_entry_stamp_cmp(const void *data1, const void *data2)
+{
+   const Ea_Search_History_Entry *entry = data1;
+   const Ea_Search_History_Entry *entry2 = data2;
+
+   if (entry->stamp == entry2->stamp) return 0;
+   return (entry->stamp > entry2->stamp) ? -1 : 1;
+}
+
+static int
+_ea_search_history_entry_key_cmp(const void *data1, const void *data2)
+{
+   const Ea_Search_History_Entry *entry = data1;
+   const Ea_Search_History_Entry *entry2 = data2;
+
+   return strcmp(entry->key, entry2->key);
+}
+
+static Eina_Bool
+_ea_search_history_entry_append(Ea_Search_History_Save *save, const char *key,
+                                const char *text, unsigned int stamp)
+{
+   Ea_Search_History_Entry *entry = save->entries + save->count;
+
+   entry->key = strdup(key);
+   entry->text = strdup(text);
+   entry->stamp = stamp;
+   if (!entry->key || !entry->text)
+     {
+        free(entry->key);
+        free(entry->text);
+        return EINA_FALSE;
+     }
+   save->count++;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_ea_search_history_items_save_cb(const Eina_Hash *hash, const void *key,
+                                 void *data, void *fdata)
+{
+   Ea_Search_History_Item *item = data;
+   Ea_Search_History_Save *save = fdata;
+
+   if (!item->text) return EINA_TRUE;
+   _ea_search_history_entry_append(save, item->key, item->text, item->stamp);
+
+   return EINA_TRUE;
+}
+
+static void
+_ea_search_history_save_free(Ea_Search_History_Save *save)
+{
+   unsigned int i;
+
+   for (i = 0; i < save->count; i++)
+     {
+        free(save->entries[i].key);
+        free(save->entries[i].text);
+     }
+   free(save->entries);
+   free(save->path);
+   free(save);
+}
+
+//Snapshot the current history. The snapshot doesn't refer to the map so it
+//can be written while the history is changing.
+static Ea_Search_History_Save *
+_ea_search_history_save_new(Ea_Search_History *hist)
+{
+   const Ea_Search_History_Record *record;
+   Ea_Search_History_Save *save;
+   const char *key;
+   unsigned int i;
+
+   save = calloc(1, sizeof(Ea_Search_History_Save));
+   if (!save) return NULL;
+
+   save->entries = malloc(sizeof(Ea_Search_History_Entry) *
+                          (hist->map_count +
+                           eina_hash_population(hist->items) + 1));
+   save->path = strdup(hist->path);
+   if (!save->entries || !save->path)
+     {
+        _ea_search_history_save_free(save);
+        return NULL;
+     }
+   save->hist = hist;
+   save->max_count = hist->max_count;
+   save->stamp = hist->stamp;
+
+   for (i = 0; i < hist->map_count; i++)
+     {
+        record = _ea_search_history_record_get(hist, i);
+        key = _ea_search_history_string_get(hist, record->key);
+        if (eina_hash_find(hist->items, key)) continue;
+        _ea_search_history_entry_append(save, key,
+                                        _ea_search_history_string_get(hist,
+                                                                      record->text),
+                                        record->stamp);
+     }
+   eina_hash_foreach(hist->items, _ea_search_history_items_save_cb, save);
+
+   hist->dirty = EINA_FALSE;
+
+   return save;
+}
+
+//Can be called in the worker thread.
+static void
+_ea_search_history_save_write(Ea_Search_History_Save *save)
+{
+   Ea_Search_History_Header *header;
+   Ea_Search_History_Record *records;
+   char tmp[PATH_MAX];
+   unsigned char *buf;
+   size_t size, offset, len, written;
+   unsigned int i;
+   ssize_t ret;
+   int fd;
+
+   save->ok = EINA_FALSE;
+
+   //Least recently used texts go away.
+   qsort(save->entries, save->count, sizeof(Ea_Search_History_Entry),
+         _ea_search_history_entry_stamp_cmp);
+   while (save->count > save->max_count)
+     {
+        save->count--;
+        free(save->entries[save->count].key);
+        free(save->entries[save->count].text);
+     }
+   qsort(save->entries, save->count, sizeof(Ea_Search_History_Entry),
+         _ea_search_history_entry_key_cmp);
+
+   size = sizeof(Ea_Search_History_Header) +
+      (sizeof(Ea_Search_History_Record) * save->count);
+   offset = size;
+   for (i = 0; i < save->count; i++)
+     size += strlen(save->entries[i].key) + strlen(save->entries[i].text) + 2;
+   if (!save->count) size++;
+   if (size > UINT32_MAX) return;
+
+   buf = calloc(1, size);
+   if (!buf) return;
+
+   header = (Ea_Search_History_Header *) buf;
+   header->magic = EA_SEARCH_HISTORY_MAGIC;
+   header->version = EA_SEARCH_HISTORY_VERSION;
+   header->count = save->count;
+   header->stamp = save->stamp;
+
+   records = (Ea_Search_History_Record *) (header + 1);
+   for (i = 0; i < save->count; i++)
+     {
+        len = strlen(save->entries[i].key) + 1;
+        memcpy(buf + offset, save->entries[i].key, len);
+        records[i].key = offset;
+        offset += len;
+
+        len = strlen(save->entries[i].text) + 1;
+        memcpy(buf + offset, save->entries[i].text, len);
+        records[i].text = offset;
+        offset += len;
+
+        records[i].stamp = save->entries[i].stamp;
+     }
+
+   //Replace the file atomically, the old one may be still mapped.
+   snprintf(tmp, sizeof(tmp), "%s.tmp", save->path);
+   fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+   if (fd < 0)
+     {
+        LOGE("Failed to open search history(%s)", tmp);
+        free(buf);
+        return;
+     }
+
+   written = 0;
+   while (written < size)
+     {
+        ret = write(fd, buf + written, size - written);
+        if (ret < 0)
+          {
+             if (errno == EINTR) continue;
+             break;
+          }
+        written += ret;
+     }
+   free(buf);
+
+   if ((written != size) || fdatasync(fd))
+     {
+        LOGE("Failed to write search history(%s)", tmp);
+        close(fd);
+        unlink(tmp);
+        return;
+     }
+   close(fd);
+
+   if (rename(tmp, save->path))
+     {
+        LOGE("Failed to replace search history(%s)", save->path);
+        unlink(tmp);
+        return;
+     }
+
+   save->ok = EINA_TRUE;
+}
+
+static void
+_ea_search_history_free(Ea_Search_History *hist)
+{
+   _ea_search_history_map_close(hist);
+   eina_hash_free(hist->items);
+   free(hist->path);
+   free(hist);
+}
+
+static void
+_ea_search_history_save_sync(Ea_Search_History *hist)
+{
+   Ea_Search_History_Save *save = _ea_search_history_save_new(hist);
+
+   if (!save) return;
+   _ea_search_history_save_write(save);
+   _ea_search_history_save_free(save);
+}
+
+static Eina_Bool
+_ea_search_history_items_saved_cb(const Eina_Hash *hash, const void *key,
+                                  void *data, void *fdata)
+{
+   Ea_Search_History_Item *item = data;
+   Ea_Search_History_Save *save = fdata;
+
+   if (item->stamp <= save->stamp)
+     save->saved_items = eina_list_append(save->saved_items, item);
+
+   return EINA_TRUE;
+}
+
+static void
+_ea_search_history_save_finish(Ea_Search_History_Save *save)
+{
+   Ea_Search_History *hist = save->hist;
+   Ea_Search_History_Item *item;
+   Eina_Bool save_ok;
+
+   hist->save_thread = NULL;
+
+   //The snapshot cleared dirty. The items are still only in memory.
+   if (!save->ok && !hist->cleared) hist->dirty = EINA_TRUE;
+
+   if (hist->cleared)
+     {
+        unlink(hist->path);
+        hist->cleared = EINA_FALSE;
+     }
+   else if (save->ok && !hist->delete_me)
+     {
+        _ea_search_history_map_close(hist);
+        _ea_search_history_map_open(hist);
+
+        //The changes up to this stamp are in the file now.
+        eina_hash_foreach(hist->items, _ea_search_history_items_saved_cb,
+                          save);
+        EINA_LIST_FREE(save->saved_items, item)
+           eina_hash_del_by_key(hist->items, item->key);
+     }
+
+   save_ok = save->ok;
+   _ea_search_history_save_free(save);
+
+   if (hist->delete_me)
+     {
+        if (hist->dirty) _ea_search_history_save_sync(hist);
+        _ea_search_history_free(hist);
+        return;
+     }
+
+   if (!hist->dirty) return;
+
+   //Retry a failed write after the save delay, not in a loop.
+   if (!save_ok)
+     {
+        if (!hist->save_timer)
+          hist->save_timer = ecore_timer_add(EA_SEARCH_HISTORY_SAVE_DELAY,
+                                             _ea_search_history_save_timer_cb,
+                                             hist);
+        return;
+     }
+   _ea_search_history_save_start(hist);
+}
+
+static void
+_ea_search_history_save_thread_cb(void *data, Ecore_Thread *thread)
+{
+   _ea_search_history_save_write(data);
+}
+
+static void
+_ea_search_history_save_end_cb(void *data, Ecore_Thread *thread)
+{
+   _ea_search_history_save_finish(data);
+}
+
+static void
+_ea_search_history_save_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   Ea_Search_History_Save *save = data;
+
+   save->ok = EINA_FALSE;
+   _ea_search_history_save_finish(save);
+}
+
+static Eina_Bool
+_ea_search_history_save_timer_cb(void *data)
+{
+   Ea_Search_History *hist = data;
+
+   hist->save_timer = NULL;
+   _ea_search_history_save_start(hist);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_ea_search_history_save_start(Ea_Search_History *hist)
+{
+   Ea_Search_History_Save *save;
+
+   if (hist->save_thread) return;
+
+   save = _ea_search_history_save_new(hist);
+   if (!save) return;
+
+   hist->save_thread = ecore_thread_run(_ea_search_history_save_thread_cb,
+                                        _ea_search_history_save_end_cb,
+                                        _ea_search_history_save_cancel_cb,
+                                        save);
+}
+
+static void
+_ea_search_history_changed(Ea_Search_History *hist)
+{
+   hist->dirty = EINA_TRUE;
+
+   //Coalesce the changes. Written back when the current save is done.
+   if (hist->save_thread || hist->save_timer) return;
+   hist->save_timer = ecore_timer_add(EA_SEARCH_HISTORY_SAVE_DELAY,
+                                      _ea_search_history_save_timer_cb, hist);
+}
+
+static Ea_Search_History_Item *
+_ea_search_history_item_get(Ea_Search_History *hist, const char *text)
+{
+   Ea_Search_History_Item *item;
+   char *key;
+
+   key = _ea_text_casefold(text);
+   if (!key) return NULL;
+
+   item = eina_hash_find(hist->items, key);
+   if (!item)
+     {
+        item = calloc(1, sizeof(Ea_Search_History_Item));
+        if (!item)
+          {
+             free(key);
+             return NULL;
+          }
+        item->key = eina_stringshare_add(key);
+        eina_hash_direct_add(hist->items, item->key, item);
+     }
+   free(key);
+
+   return item;
+}
+
+static void
+_ea_search_history_activated_cb(void *data, Evas_Object *obj, void *event_info)
+{
+   Ea_Editfield_Data *eed = _ea_editfield_data_get(obj);
+
+   if (!eed || !eed->search_history) return;
+
+   ea_search_history_add(eed->search_history, ea_editfield_text_utf8_get(obj));
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API Ea_Search_History *
+ea_search_history_open(const char *path, unsigned int max_count)
+{
+   Ea_Search_History *hist;
+
+   if (!path || !max_count) return NULL;
+
+   hist = calloc(1, sizeof(Ea_Search_History));
+   if (!hist)
+     {
+        LOGE("Failed to allocate search history");
+        return NULL;
+     }
+   hist->path = strdup(path);
+   hist->max_count = max_count;
+   hist->items = eina_hash_string_superfast_new(_ea_search_history_item_free);
+   if (!hist->path || !hist->items)
+     {
+        LOGE("Failed to allocate search history");
+        _ea_search_history_free(hist);
+        return NULL;
+     }
+
+   _ea_search_history_map_open(hist);
+
+   return hist;
+}
+
+EXPORT_API void
+ea_search_history_close(Ea_Search_History *hist)
+{
+   if (!hist) return;
+
+   if (hist->save_timer)
+     {
+        ecore_timer_del(hist->save_timer);
+        hist->save_timer = NULL;
+     }
+
+   //Freed when the running save is done.
+   if (hist->save_thread)
+     {
+        hist->delete_me = EINA_TRUE;
+        return;
+     }
+
+   if (hist->dirty) _ea_search_history_save_sync(hist);
+   _ea_search_history_free(hist);
+}
+
+EXPORT_API void
+ea_search_history_add(Ea_Search_History *hist, const char *text)
+{
+   Ea_Search_History_Item *item;
+
+   if (!hist || !text || !text[0]) return;
+
+   item = _ea_search_history_item_get(hist, text);
+   if (!item) return;
+
+   eina_stringshare_replace(&item->text, text);
+   item->stamp = ++hist->stamp;
+
+   _ea_search_history_changed(hist);
+}
+
+EXPORT_API void
+ea_search_history_remove(Ea_Search_History *hist, const char *text)
+{
+   Ea_Search_History_Item *item;
+
+   if (!hist || !text || !text[0]) return;
+
+   item = _ea_search_history_item_get(hist, text);
+   if (!item) return;
+
+   eina_stringshare_replace(&item->text, NULL);
+   item->stamp = ++hist->stamp;
+
+   _ea_search_history_changed(hist);
+}
+
+EXPORT_API void
+ea_search_history_clear(Ea_Search_History *hist)
+{
+   if (!hist) return;
+
+   if (hist->save_timer)
+     {
+        ecore_timer_del(hist->save_timer);
+        hist->save_timer = NULL;
+     }
+   if (hist->save_thread) hist->cleared = EINA_TRUE;
+
+   eina_hash_free_buckets(hist->items);
+   _ea_search_history_map_close(hist);
+   unlink(hist->path);
+   hist->dirty = EINA_FALSE;
+}
+
+EXPORT_API Eina_List *
+ea_search_history_lookup(Ea_Search_History *hist, const char *prefix, unsigned int max_count)
+{
+   const Ea_Search_History_Record *record;
+   Ea_Search_History_Lookup lookup;
+   Eina_List *ret = NULL;
+   const char *key;
+   char *folded;
+   unsigned int i;
+
+   if (!hist || !max_count) return NULL;
+
+   folded = _ea_text_casefold(prefix ? prefix : "");
+   if (!folded) return NULL;
+
+   lookup.key = folded;
+   lookup.key_len = strlen(folded);
+   lookup.count = 0;
+   lookup.max_count = max_count;
+   lookup.matches = malloc(sizeof(Ea_Search_History_Match) * max_count);
+   if (!lookup.matches)
+     {
+        free(folded);
+        return NULL;
+     }
+
+   //The records are sorted by the key, so the matches are in a row.
+   for (i = _ea_search_history_lower_bound(hist, lookup.key, lookup.key_len);
+        i < hist->map_count; i++)
+     {
+        record = _ea_search_history_record_get(hist, i);
+        key = _ea_search_history_string_get(hist, record->key);
+        if (strncmp(key, lookup.key, lookup.key_len)) break;
+        //Changed after the last save.
+        if (eina_hash_find(hist->items, key)) continue;
+        _ea_search_history_match_add(&lookup,
+                                     _ea_search_history_string_get(hist,
+                                                                   record->text),
+                                     record->stamp);
+     }
+   eina_hash_foreach(hist->items, _ea_search_history_items_lookup_cb, &lookup);
+
+   for (i = 0; i < lookup.count; i++)
+     ret = eina_list_append(ret, eina_stringshare_add(lookup.matches[i].text));
+
+   free(lookup.matches);
+   free(folded);
+
+   return ret;
+}
+
+EXPORT_API void
+ea_editfield_search_history_set(Evas_Object *obj, Ea_Search_History *hist)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return;
+
+   if (!eed->search_history && hist)
+     evas_object_smart_callback_add(obj, "activated",
+                                    _ea_search_history_activated_cb, NULL);
+   else if (eed->search_history && !hist)
+     evas_object_smart_callback_del(obj, "activated",
+                                    _ea_search_history_activated_cb);
+
+   eed->search_history = hist;
+}
+
+EXPORT_API Ea_Search_History *
+ea_editfield_search_history_get(Evas_Object *obj)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed) return NULL;
+
+   return eed->search_history;
+}
+
+EXPORT_API Eina_List *
+ea_editfield_search_history_suggestions_get(Evas_Object *obj, unsigned int max_count)
+{
+   Ea_Editfield_Data *eed;
+
+   eed = _ea_editfield_data_get(obj);
+   if (!eed || !eed->search_history) return NULL;
+
+   return ea_search_history_lookup(eed->search_history,
+                                   ea_editfield_text_utf8_get(obj), max_count);
+}
@@ -0,0 +1,513 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# define EA_TEXT_X86 1
+# include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define EA_TEXT_NEON 1
+# include <arm_neon.h>
+# if defined(__arm__)
+#  include <sys/auxv.h>
+#  ifndef HWCAP_NEON
+#   define HWCAP_NEON (1 << 12)
+#  endif
+# endif
+#endif
+
+/* Invalid UTF-8 bytes are mapped to this range so they never compare equal
+ * to a real code point. */
+#define EA_TEXT_INVALID_BASE 0xDC00
+
+/* Enough for the realized items of a few lists. */
+#define EA_TEXT_HIGHLIGHT_CACHE_MAX 512
+
+/* Returns the index of the first byte b of s for which (b | mask) == c,
+ * or len if there is none. */
+typedef size_t (*Ea_Text_Scan_Func)(const unsigned char *s, size_t len,
+                                    unsigned char c, unsigned char mask);
+
+static size_t _ea_text_scan_scalar(const unsigned char *s, size_t len,
+                                   unsigned char c, unsigned char mask);
+
+static Ea_Text_Scan_Func _ea_text_scan = _ea_text_scan_scalar;
+
+//Highlighted markups of the current query, keyed by the label. A new query
+//starts a new generation and drops all of them at once.
+static Eina_Hash *highlights = NULL;
+static const char *highlight_query = NULL;   //stringshared
+
+static inline Eina_Unicode
+_ea_text_fold(Eina_Unicode c)
+{
+   if (c < 0x80)
+     return ((c >= 'A') && (c <= 'Z')) ? c + 0x20 : c;
+
+   //Latin-1 Supplement
+   if (c < 0x100)
+     return ((c >= 0xC0) && (c <= 0xDE) && (c != 0xD7)) ? c + 0x20 : c;
+
+   //Latin Extended-A. Never fold into ASCII, the scan kernels rely on it.
+   if (c < 0x180)
+     {
+        if ((c >= 0x139) && (c <= 0x148)) return (c & 1) ? c + 1 : c;
+        if ((c >= 0x179) && (c <= 0x17E)) return (c & 1) ? c + 1 : c;
+        if (c == 0x178) return 0xFF;
+        if ((c == 0x130) || (c == 0x131) || (c == 0x138) || (c == 0x149) ||
+            (c == 0x17F))
+          return c;
+        return c | 1;
+     }
+
+   //Greek
+   if ((c >= 0x370) && (c < 0x400))
+     {
+        if ((c >= 0x391) && (c <= 0x3AB) && (c != 0x3A2)) return c + 0x20;
+        if (c == 0x386) return 0x3AC;
+        if ((c >= 0x388) && (c <= 0x38A)) return c + 0x25;
+        if (c == 0x38C) return 0x3CC;
+        if ((c == 0x38E) || (c == 0x38F)) return c + 0x3F;
+        if (c == 0x3C2) return 0x3C3;
+        return c;
+     }
+
+   //Cyrillic
+   if ((c >= 0x400) && (c < 0x530))
+     {
+        if (c < 0x410) return c + 0x50;
+        if (c < 0x430) return c + 0x20;
+        if (c < 0x460) return c;
+        if ((c < 0x482) || ((c >= 0x48A) && (c < 0x4C0)) || (c >= 0x4D0))
+          return c | 1;
+        if (c == 0x4C0) return 0x4CF;
+        if ((c >= 0x4C1) && (c <= 0x4CE)) return (c & 1) ? c + 1 : c;
+        return c;
+     }
+
+   return c;
+}
+
+static inline Eina_Unicode
+_ea_text_utf8_get(const unsigned char *s, const unsigned char *end, int *len)
+{
+   Eina_Unicode c = s[0];
+   int n, i;
+
+   if (c < 0x80)
+     {
+        *len = 1;
+        return c;
+     }
+   else if ((c & 0xE0) == 0xC0)
+     {
+        n = 2;
+        c &= 0x1F;
+     }
+   else if ((c & 0xF0) == 0xE0)
+     {
+        n = 3;
+        c &= 0x0F;
+     }
+   else if ((c & 0xF8) == 0xF0)
+     {
+        n = 4;
+        c &= 0x07;
+     }
+   else
+     goto invalid;
+
+   if (end - s < n) goto invalid;
+
+   for (i = 1; i < n; i++)
+     {
+        if ((s[i] & 0xC0) != 0x80) goto invalid;
+        c = (c << 6) | (s[i] & 0x3F);
+     }
+   *len = n;
+   return c;
+
+invalid:
+   *len = 1;
+   return EA_TEXT_INVALID_BASE + s[0];
+}
+
+/* Match query at the beginning of s. Returns the matched length of s in bytes
+ * or -1. */
+static int
+_ea_text_match_at(const unsigned char *s, const unsigned char *send,
+                  const unsigned char *q, const unsigned char *qend)
+{
+   const unsigned char *start = s;
+   Eina_Unicode c1, c2;
+   int l1, l2;
+
+   while (q < qend)
+     {
+        if (s >= send) return -1;
+
+        //ASCII fast path
+        if ((*q < 0x80) && (*s < 0x80))
+          {
+             if (_ea_text_fold(*q) != _ea_text_fold(*s)) return -1;
+             q++;
+             s++;
+             continue;
+          }
+
+        c1 = _ea_text_utf8_get(q, qend, &l1);
+        c2 = _ea_text_utf8_get(s, send, &l2);
+        if (_ea_text_fold(c1) != _ea_text_fold(c2)) return -1;
+        q += l1;
+        s += l2;
+     }
+
+   return s - start;
+}
+
+static size_t
+_ea_text_scan_scalar(const unsigned char *s, size_t len, unsigned char c,
+                     unsigned char mask)
+{
+   size_t i;
+
+   for (i = 0; i < len; i++)
+     {
+        if ((s[i] | mask) == c) return i;
+     }
+   return len;
+}
+
+#ifdef EA_TEXT_X86
+__attribute__((target("sse2"))) static size_t
+_ea_text_scan_sse2(const unsigned char *s, size_t len, unsigned char c,
+                   unsigned char mask)
+{
+   __m128i vc = _mm_set1_epi8((char) c);
+   __m128i vm = _mm_set1_epi8((char) mask);
+   __m128i v;
+   unsigned int bits;
+   size_t i;
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        v = _mm_loadu_si128((const __m128i *) (s + i));
+        bits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(v, vm), vc));
+        if (bits) return i + __builtin_ctz(bits);
+     }
+
+   return i + _ea_text_scan_scalar(s + i, len - i, c, mask);
+}
+
+__attribute__((target("avx2"))) static size_t
+_ea_text_scan_avx2(const unsigned char *s, size_t len, unsigned char c,
+                   unsigned char mask)
+{
+   __m256i vc = _mm256_set1_epi8((char) c);
+   __m256i vm = _mm256_set1_epi8((char) mask);
+   __m256i v;
+   unsigned int bits;
+   size_t i;
+
+   for (i = 0; i + 32 <= len; i += 32)
+     {
+        v = _mm256_loadu_si256((const __m256i *) (s + i));
+        bits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(v, vm),
+                                                      vc));
+        if (bits) return i + __builtin_ctz(bits);
+     }
+
+   return i + _ea_text_scan_sse2(s + i, len - i, c, mask);
+}
+#endif
+
+#ifdef EA_TEXT_NEON
+static size_t
+_ea_text_scan_neon(const unsigned char *s, size_t len, unsigned char c,
+                   unsigned char mask)
+{
+   uint8x16_t vc = vdupq_n_u8(c);
+   uint8x16_t vm = vdupq_n_u8(mask);
+   uint64x2_t eq;
+   size_t i;
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        eq = vreinterpretq_u64_u8(vceqq_u8(vorrq_u8(vld1q_u8(s + i), vm), vc));
+        if (vgetq_lane_u64(eq, 0) | vgetq_lane_u64(eq, 1))
+          return i + _ea_text_scan_scalar(s + i, 16, c, mask);
+     }
+
+   return i + _ea_text_scan_scalar(s + i, len - i, c, mask);
+}
+#endif
+
+static inline int
+_ea_text_utf8_put(unsigned char *d, Eina_Unicode c)
+{
+   if (c < 0x80)
+     {
+        d[0] = c;
+        return 1;
+     }
+   else if (c < 0x800)
+     {
+        d[0] = 0xC0 | (c >> 6);
+        d[1] = 0x80 | (c & 0x3F);
+        return 2;
+     }
+   else if (c < 0x10000)
+     {
+        d[0] = 0xE0 | (c >> 12);
+        d[1] = 0x80 | ((c >> 6) & 0x3F);
+        d[2] = 0x80 | (c & 0x3F);
+        return 3;
+     }
+   d[0] = 0xF0 | (c >> 18);
+   d[1] = 0x80 | ((c >> 12) & 0x3F);
+   d[2] = 0x80 | ((c >> 6) & 0x3F);
+   d[3] = 0x80 | (c & 0x3F);
+   return 4;
+}
+
+static const char *
+_ea_text_highlight_build(const char *label, const char *query)
+{
+   Eina_Strbuf *buf;
+   const char *s = label, *m, *ret;
+   int len;
+
+   buf = eina_strbuf_new();
+   if (!buf) return NULL;
+
+   if (query[0])
+     {
+        while ((m = ea_text_match_find(s, query, &len)) && (len > 0))
+          {
+             _ea_text_markup_escape_append(buf, s, m - s);
+             eina_strbuf_append(buf, "<match>");
+             _ea_text_markup_escape_append(buf, m, len);
+             eina_strbuf_append(buf, "</match>");
+             s = m + len;
+          }
+     }
+   _ea_text_markup_escape_append(buf, s, strlen(s));
+
+   ret = eina_stringshare_add(eina_strbuf_string_get(buf));
+   eina_strbuf_free(buf);
+
+   return ret;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+char *
+_ea_text_casefold(const char *str)
+{
+   const unsigned char *s = (const unsigned char *) str;
+   const unsigned char *send;
+   unsigned char *ret, *d;
+   Eina_Unicode c;
+   size_t len;
+   int l;
+
+   if (!str) return NULL;
+
+   len = strlen(str);
+   send = s + len;
+
+   //Folding never changes the encoded length of a code point.
+   ret = malloc(len + 1);
+   if (!ret) return NULL;
+
+   d = ret;
+   while (s < send)
+     {
+        if (*s < 0x80)
+          {
+             *d++ = _ea_text_fold(*s++);
+             continue;
+          }
+        c = _ea_text_utf8_get(s, send, &l);
+        if (c >= EA_TEXT_INVALID_BASE && l == 1) *d++ = *s;
+        else d += _ea_text_utf8_put(d, _ea_text_fold(c));
+        s += l;
+     }
+   *d = '\0';
+
+   return (char *) ret;
+}
+
+void
+_ea_text_init(void)
+{
+#ifdef EA_TEXT_X86
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+     _ea_text_scan = _ea_text_scan_avx2;
+   else if (__builtin_cpu_supports("sse2"))
+     _ea_text_scan = _ea_text_scan_sse2;
+#elif defined(EA_TEXT_NEON) && defined(__arm__)
+   if (getauxval(AT_HWCAP) & HWCAP_NEON)
+     _ea_text_scan = _ea_text_scan_neon;
+#elif defined(EA_TEXT_NEON)
+   _ea_text_scan = _ea_text_scan_neon;
+#endif
+}
+
+void
+_ea_text_markup_escape_append(Eina_Strbuf *buf, const char *str, size_t len)
+{
+   const char *end = str + len;
+   const char *run = str;
+   const char *esc;
+
+   for (; str < end; str++)
+     {
+        switch (*str)
+          {
+           case '<': esc = "&lt;"; break;
+           case '>': esc = "&gt;"; break;
+           case '&': esc = "&amp;"; break;
+           case '\n': esc = "<br/>"; break;
+           case '\t': esc = "<tab/>"; break;
+           case '\r': esc = ""; break;
+           default: continue;
+          }
+        if (str > run) eina_strbuf_append_length(buf, run, str - run);
+        eina_strbuf_append(buf, esc);
+        run = str + 1;
+     }
+   if (end > run) eina_strbuf_append_length(buf, run, end - run);
+}
+
+void
+_ea_text_trim(void)
+{
+   if (highlights)
+     {
+        eina_hash_free(highlights);
+        highlights = NULL;
+     }
+   eina_stringshare_replace(&highlight_query, NULL);
+}
+
+/*===========================================================================*
+ *                                  API                                      *
+ *===========================================================================*/
+
+EXPORT_API const char *
+ea_text_match_find(const char *str, const char *query, int *len)
+{
+   const unsigned char *s = (const unsigned char *) str;
+   const unsigned char *q = (const unsigned char *) query;
+   const unsigned char *send, *qend;
+   unsigned char c, mask;
+   size_t slen, pos;
+   int m, l;
+
+   if (!str || !query) return NULL;
+
+   slen = strlen(str);
+   send = s + slen;
+   qend = q + strlen(query);
+
+   if (q == qend)
+     {
+        if (len) *len = 0;
+        return str;
+     }
+
+   if (q[0] < 0x80)
+     {
+        //Let the vector kernel skip to the bytes that can start a match.
+        c = _ea_text_fold(q[0]);
+        mask = ((c >= 'a') && (c <= 'z')) ? 0x20 : 0x00;
+
+        pos = 0;
+        while (pos < slen)
+          {
+             pos += _ea_text_scan(s + pos, slen - pos, c, mask);
+             if (pos >= slen) break;
+
+             m = _ea_text_match_at(s + pos, send, q, qend);
+             if (m >= 0)
+               {
+                  if (len) *len = m;
+                  return str + pos;
+               }
+             pos++;
+          }
+        return NULL;
+     }
+
+   while (s < send)
+     {
+        m = _ea_text_match_at(s, send, q, qend);
+        if (m >= 0)
+          {
+             if (len) *len = m;
+             return (const char *) s;
+          }
+        _ea_text_utf8_get(s, send, &l);
+        s += l;
+     }
+
+   return NULL;
+}
+
+EXPORT_API Eina_Bool
+ea_text_match(const char *str, const char *query)
+{
+   return !!ea_text_match_find(str, query, NULL);
+}
+
+EXPORT_API Eina_Bool
+ea_text_match_prefix(const char *str, const char *prefix)
+{
+   const unsigned char *s = (const unsigned char *) str;
+   const unsigned char *p = (const unsigned char *) prefix;
+
+   if (!str || !prefix) return EINA_FALSE;
+
+   return _ea_text_match_at(s, s + strlen(str), p, p + strlen(prefix)) >= 0;
+}
+
+EXPORT_API char *
+ea_text_highlight(const char *label, const char *query)
+{
+   const char *markup;
+   char *ret;
+
+   if (!label) return NULL;
+   if (!query) query = "";
+
+   if (!highlight_query || strcmp(highlight_query, query))
+     {
+        _ea_text_trim();
+        eina_stringshare_replace(&highlight_query, query);
+     }
+
+   if (!highlights)
+     {
+        highlights = eina_hash_string_superfast_new(EINA_FREE_CB(eina_stringshare_del));
+        if (!highlights) return NULL;
+     }
+
+   markup = eina_hash_find(highlights, label);
+   if (markup) return strdup(markup);
+
+   markup = _ea_text_highlight_build(label, query);
+   if (!markup) return NULL;
+
+   if (eina_hash_population(highlights) >= EA_TEXT_HIGHLIGHT_CACHE_MAX)
+     eina_hash_free_buckets(highlights);
+   ret = strdup(markup);
+   if (!eina_hash_add(highlights, label, markup))
+     eina_stringshare_del(markup);
+
+   return ret;
+}
@@ -0,0 +1,257 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+#include <tts.h>
+
+#ifndef EA_TTS_SONAME
+# define EA_TTS_SONAME "libtts.so.0"
+#endif
+
+//libtts is loaded when the screen reader speaks for the first time, so the
+//processes which don't use the screen reader don't load the TTS client.
+static struct
+{
+   __typeof__(tts_create) *tts_create;
+   __typeof__(tts_destroy) *tts_destroy;
+   __typeof__(tts_set_mode) *tts_set_mode;
+   __typeof__(tts_prepare) *tts_prepare;
+   __typeof__(tts_unprepare) *tts_unprepare;
+   __typeof__(tts_get_state) *tts_get_state;
+   __typeof__(tts_add_text) *tts_add_text;
+   __typeof__(tts_play) *tts_play;
+   __typeof__(tts_stop) *tts_stop;
+   __typeof__(tts_set_state_changed_cb) *tts_set_state_changed_cb;
+   __typeof__(tts_unset_state_changed_cb) *tts_unset_state_changed_cb;
+   __typeof__(tts_set_utterance_completed_cb) *tts_set_utterance_completed_cb;
+   __typeof__(tts_unset_utterance_completed_cb) *tts_unset_utterance_completed_cb;
+} tts_api;
+
+static const Ea_Dl_Symbol tts_symbols[] =
+{
+   EA_DL_SYMBOL(tts_api, tts_create),
+   EA_DL_SYMBOL(tts_api, tts_destroy),
+   EA_DL_SYMBOL(tts_api, tts_set_mode),
+   EA_DL_SYMBOL(tts_api, tts_prepare),
+   EA_DL_SYMBOL(tts_api, tts_unprepare),
+   EA_DL_SYMBOL(tts_api, tts_get_state),
+   EA_DL_SYMBOL(tts_api, tts_add_text),
+   EA_DL_SYMBOL(tts_api, tts_play),
+   EA_DL_SYMBOL(tts_api, tts_stop),
+   EA_DL_SYMBOL(tts_api, tts_set_state_changed_cb),
+   EA_DL_SYMBOL(tts_api, tts_unset_state_changed_cb),
+   EA_DL_SYMBOL(tts_api, tts_set_utterance_completed_cb),
+   EA_DL_SYMBOL(tts_api, tts_unset_utterance_completed_cb),
+   { NULL, NULL }
+};
+
+static Ea_Dl_Lib tts_lib = { EA_TTS_SONAME, tts_symbols, NULL, EINA_FALSE };
+
+static tts_h tts = NULL;
+static Ea_Tts_State_Changed_Cb state_func = NULL;
+static Ea_Tts_Completed_Cb completed_func = NULL;
+
+static Ea_Tts_State
+_ea_tts_state_convert(tts_state_e state)
+{
+   switch (state)
+     {
+      case TTS_STATE_READY:
+         return EA_TTS_STATE_READY;
+      case TTS_STATE_PLAYING:
+         return EA_TTS_STATE_PLAYING;
+      case TTS_STATE_PAUSED:
+         return EA_TTS_STATE_PAUSED;
+      default:
+         return EA_TTS_STATE_CREATED;
+     }
+}
+
+static void
+_ea_tts_state_changed_cb(tts_h tts, tts_state_e previous, tts_state_e current, void *data)
+{
+   if (state_func)
+     state_func(_ea_tts_state_convert(previous), _ea_tts_state_convert(current));
+}
+
+static void
+_ea_tts_utterance_completed_cb(tts_h tts, int utt_id, void *data)
+{
+   if (completed_func) completed_func(utt_id);
+}
+
+static Eina_Bool
+_ea_tts_init(Ea_Tts_State_Changed_Cb state_cb, Ea_Tts_Completed_Cb completed_cb)
+{
+   int ret = 0;
+
+   if (!_ea_dl_load(&tts_lib)) return EINA_FALSE;
+
+   ret = tts_api.tts_create(&tts);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to get handle : result(%d)", ret);
+        tts = NULL;
+        return EINA_FALSE;
+     }
+
+   ret = tts_api.tts_set_state_changed_cb(tts, _ea_tts_state_changed_cb, NULL);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to set callback : result(%d)", ret);
+        goto error;
+     }
+
+   ret = tts_api.tts_set_utterance_completed_cb(tts, _ea_tts_utterance_completed_cb, NULL);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to set callback : result(%d)", ret);
+        goto error;
+     }
+
+   ret = tts_api.tts_set_mode(tts, TTS_MODE_SCREEN_READER);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to set mode : result(%d)", ret);
+        goto error;
+     }
+
+   state_func = state_cb;
+   completed_func = completed_cb;
+
+   //tts_prepare() works asynchronously. The state callback tells when it is ready.
+   ret = tts_api.tts_prepare(tts);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to prepare handle : result(%d)", ret);
+        goto error;
+     }
+
+   return EINA_TRUE;
+
+error:
+   tts_api.tts_destroy(tts);
+   tts = NULL;
+   state_func = NULL;
+   completed_func = NULL;
+   return EINA_FALSE;
+}
+
+static void
+_ea_tts_shutdown(void)
+{
+   tts_state_e state;
+   int ret = 0;
+
+   if (!tts) return;
+
+   tts_api.tts_get_state(tts, &state);
+   if (state == TTS_STATE_PLAYING || state == TTS_STATE_PAUSED)
+     {
+        ret = tts_api.tts_stop(tts);
+        if (TTS_ERROR_NONE != ret)
+          LOGE("Fail to stop handle : result(%d)", ret);
+        tts_api.tts_get_state(tts, &state);
+     }
+
+   //It is possible to shutdown before the state is ready,
+   //because tts_prepare() works asynchronously.
+   if (state != TTS_STATE_CREATED)
+     {
+        ret = tts_api.tts_unprepare(tts);
+        if (TTS_ERROR_NONE != ret)
+          LOGE("Fail to unprepare handle : result(%d)", ret);
+     }
+
+   ret = tts_api.tts_unset_utterance_completed_cb(tts);
+   if (TTS_ERROR_NONE != ret)
+     LOGE("Fail to unset callback : result(%d)", ret);
+
+   ret = tts_api.tts_unset_state_changed_cb(tts);
+   if (TTS_ERROR_NONE != ret)
+     LOGE("Fail to unset callback : result(%d)", ret);
+
+   ret = tts_api.tts_destroy(tts);
+   if (TTS_ERROR_NONE != ret)
+     LOGE("Fail to destroy handle : result(%d)", ret);
+
+   tts = NULL;
+   state_func = NULL;
+   completed_func = NULL;
+}
+
+static Ea_Tts_State
+_ea_tts_state_get(void)
+{
+   tts_state_e state;
+
+   if (!tts || (tts_api.tts_get_state(tts, &state) != TTS_ERROR_NONE))
+     return EA_TTS_STATE_CREATED;
+
+   return _ea_tts_state_convert(state);
+}
+
+static Eina_Bool
+_ea_tts_text_add(const char *text, int *id)
+{
+   int ret = 0;
+
+   ret = tts_api.tts_add_text(tts, text, NULL, TTS_VOICE_TYPE_AUTO, TTS_SPEED_AUTO, id);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to add kept text : ret(%d)", ret);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_ea_tts_play(void)
+{
+   int ret = 0;
+
+   ret = tts_api.tts_play(tts);
+   if (TTS_ERROR_NONE != ret)
+     {
+        LOGE("Fail to play TTS : ret(%d)", ret);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_ea_tts_stop(void)
+{
+   int ret = 0;
+
+   ret = tts_api.tts_stop(tts);
+   if (TTS_ERROR_NONE != ret)
+     LOGE("Fail to stop handle : result(%d)", ret);
+}
+
+static const Ea_Tts_Backend _ea_tts_backend =
+{
+   "tts",
+   _ea_tts_init,
+   _ea_tts_shutdown,
+   _ea_tts_state_get,
+   _ea_tts_text_add,
+   _ea_tts_play,
+   _ea_tts_stop
+};
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+const Ea_Tts_Backend *
+_ea_tts_backend_get(void)
+{
+   const char *name = getenv("EA_TTS_BACKEND");
+
+   //The local backend works without the platform TTS daemon.
+   if (name && !strcmp(name, _ea_tts_local_backend.name))
+     return &_ea_tts_local_backend;
+
+   return &_ea_tts_backend;
+}
@@ -0,0 +1,221 @@
+#include "efl_assist.h"
+#include "efl_assist_private.h"
+
+/* A stand-in for the platform TTS engine. It follows the same state machine
+ * with timers and logs the utterances instead of saying them, so the screen
+ * reader path can be run and timed without the TTS daemon.
+ * Set EA_TTS_BACKEND=local to use it. EA_TTS_LOCAL_SCALE scales the simulated
+ * times, 0 makes them as short as the main loop allows. */
+
+#define EA_TTS_LOCAL_PREPARE_TIME 0.3    //seconds
+#define EA_TTS_LOCAL_START_TIME   0.1    //seconds per utterance
+#define EA_TTS_LOCAL_CHAR_TIME    0.06   //seconds per character
+
+typedef struct _Ea_Tts_Local_Text
+{
+   int id;
+   const char *text;   //stringshared
+   double added;       //when the text was added, for the start latency
+} Ea_Tts_Local_Text;
+
+static Ea_Tts_State state = EA_TTS_STATE_CREATED;
+static Ea_Tts_State_Changed_Cb state_func = NULL;
+static Ea_Tts_Completed_Cb completed_func = NULL;
+static Eina_List *texts = NULL;
+static Ecore_Timer *prepare_timer = NULL;
+static Ecore_Timer *speak_timer = NULL;
+static double scale = 1.0;
+static int last_id = 0;
+
+static void
+_ea_tts_local_state_set(Ea_Tts_State current)
+{
+   Ea_Tts_State previous = state;
+
+   if (previous == current) return;
+   state = current;
+   if (state_func) state_func(previous, current);
+}
+
+static void
+_ea_tts_local_text_free(Ea_Tts_Local_Text *item)
+{
+   eina_stringshare_del(item->text);
+   _ea_mem_free(EA_MEMORY_TTS, item, sizeof(Ea_Tts_Local_Text));
+}
+
+static double
+_ea_tts_local_duration_get(const char *text)
+{
+   const unsigned char *s = (const unsigned char *) text;
+   int chars = 0;
+
+   for (; *s; s++)
+     {
+        if ((*s & 0xC0) != 0x80) chars++;
+     }
+
+   return scale * (EA_TTS_LOCAL_START_TIME + (EA_TTS_LOCAL_CHAR_TIME * chars));
+}
+
+static void _ea_tts_local_next(void);
+
+static Eina_Bool
+_ea_tts_local_speak_timer_cb(void *data)
+{
+   Ea_Tts_Local_Text *item;
+
+   speak_timer = NULL;
+   item = eina_list_data_get(texts);
+   texts = eina_list_remove_list(texts, texts);
+
+   LOGI("[tts-local] done(%d)", item->id);
+   if (completed_func) completed_func(item->id);
+   _ea_tts_local_text_free(item);
+
+   _ea_tts_local_next();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_ea_tts_local_next(void)
+{
+   Ea_Tts_Local_Text *item;
+
+   if ((state != EA_TTS_STATE_PLAYING) || speak_timer || !texts) return;
+
+   item = eina_list_data_get(texts);
+   LOGI("[tts-local] start(%d) after %.3fs: %s", item->id,
+        ecore_time_get() - item->added, item->text);
+   speak_timer = ecore_timer_add(_ea_tts_local_duration_get(item->text),
+                                 _ea_tts_local_speak_timer_cb, NULL);
+}
+
+static Eina_Bool
+_ea_tts_local_prepare_timer_cb(void *data)
+{
+   prepare_timer = NULL;
+   LOGI("[tts-local] ready");
+   _ea_tts_local_state_set(EA_TTS_STATE_READY);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_ea_tts_local_init(Ea_Tts_State_Changed_Cb state_cb, Ea_Tts_Completed_Cb completed_cb)
+{
+   const char *str = getenv("EA_TTS_LOCAL_SCALE");
+
+   scale = str ? atof(str) : 1.0;
+   if (scale < 0.0) scale = 0.0;
+
+   prepare_timer = ecore_timer_add(scale * EA_TTS_LOCAL_PREPARE_TIME,
+                                   _ea_tts_local_prepare_timer_cb, NULL);
+   if (!prepare_timer)
+     {
+        LOGE("Fail to prepare local TTS");
+        return EINA_FALSE;
+     }
+
+   state = EA_TTS_STATE_CREATED;
+   state_func = state_cb;
+   completed_func = completed_cb;
+   LOGI("[tts-local] created");
+
+   return EINA_TRUE;
+}
+
+static void
+_ea_tts_local_stop(void)
+{
+   Ea_Tts_Local_Text *item;
+
+   if (speak_timer)
+     {
+        ecore_timer_del(speak_timer);
+        speak_timer = NULL;
+     }
+   EINA_LIST_FREE(texts, item)
+     {
+        LOGI("[tts-local] stopped(%d)", item->id);
+        _ea_tts_local_text_free(item);
+     }
+
+   if (state != EA_TTS_STATE_CREATED)
+     _ea_tts_local_state_set(EA_TTS_STATE_READY);
+}
+
+static void
+_ea_tts_local_shutdown(void)
+{
+   state_func = NULL;
+   completed_func = NULL;
+   _ea_tts_local_stop();
+
+   if (prepare_timer)
+     {
+        ecore_timer_del(prepare_timer);
+        prepare_timer = NULL;
+     }
+   state = EA_TTS_STATE_CREATED;
+   LOGI("[tts-local] destroyed");
+}
+
+static Ea_Tts_State
+_ea_tts_local_state_get(void)
+{
+   return state;
+}
+
+static Eina_Bool
+_ea_tts_local_text_add(const char *text, int *id)
+{
+   Ea_Tts_Local_Text *item;
+
+   if (state == EA_TTS_STATE_CREATED) return EINA_FALSE;
+
+   item = _ea_mem_calloc(EA_MEMORY_TTS, sizeof(Ea_Tts_Local_Text));
+   if (!item)
+     {
+        LOGE("Failed to allocate local TTS text");
+        return EINA_FALSE;
+     }
+   item->id = ++last_id;
+   item->text = eina_stringshare_add(text);
+   item->added = ecore_time_get();
+   texts = eina_list_append(texts, item);
+
+   LOGI("[tts-local] add(%d): %s", item->id, text);
+   if (id) *id = item->id;
+
+   _ea_tts_local_next();
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_ea_tts_local_play(void)
+{
+   if (state == EA_TTS_STATE_CREATED) return EINA_FALSE;
+
+   _ea_tts_local_state_set(EA_TTS_STATE_PLAYING);
+   _ea_tts_local_next();
+
+   return EINA_TRUE;
+}
+
+/*===========================================================================*
+ *                                Global                                     *
+ *===========================================================================*/
+
+const Ea_Tts_Backend _ea_tts_local_backend =
+{
+   "local",
+   _ea_tts_local_init,
+   _ea_tts_local_shutdown,
+   _ea_tts_local_state_get,
+   _ea_tts_local_text_add,
+   _ea_tts_local_play,
+   _ea_tts_local_stop
+};